@@ -0,0 +1,12 @@
+// Nested loops adding a constant step: the reduced product must reach
+// its fixpoint also with thresholds (./while -t -p).
+v2 := 0;
+i0 := 4;
+while i0 > 0 do(
+  i1 := 4;
+  while i1 > 0 do(
+    v2 := v2 + 6;
+    i1 := i1 - 1;
+  );
+  i0 := i0 - 1;
+);
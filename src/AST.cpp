@@ -1,111 +1,160 @@
 /** Abstract syntax tree.
  * Class handling an abstract syntax tree, built by the parser. Such a
  * tree can be traversed to perform an abstract interpretation.
- * 
+ *
  * @file AST.cpp
  * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
  */
+#include <limits.h>
 #include <stdio.h>
+#include <string.h>
 #include <iostream>
 #include <fstream>
+#include <string_view>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "AST.hpp"
+#include "domains/Interval.hpp"
+#include "domains/Zone.hpp"
+#include "domains/Octagon.hpp"
 
 
-/** Constructor of a 0-ary statement abstract syntax node.
- * 0-ary statements are: skip (Skp).
- * @param[in]  type        Type of the statement
+const AST::Index AST::None;
+
+
+/** Type representing the header of a binary cache file.
+ * Header is written word by word after the magic string, so that the
+ * file holds no padding.
+ */
+typedef struct{
+  char     magic[8];      ///< Magic string identifying the format
+  uint32_t version;       ///< Version of the format
+  uint32_t order;         ///< Byte order mark
+  uint32_t nodeSize;      ///< Size of a node record
+  uint32_t nodes;         ///< Number of nodes
+  uint32_t root;          ///< Index of the root node
+  uint32_t blocks;        ///< Number of blocks
+  uint32_t statements;    ///< Number of statements in every block
+  uint32_t symbols;       ///< Number of variables
+  uint32_t names;         ///< Size of the names, terminators included
+} CacheHeader;
+
+static const char     cacheMagic[8] = {'W','H','I','L','E','A','S','T'};
+static const uint32_t cacheVersion  = 2;
+static const uint32_t cacheOrder    = 0x01020304;
+
+// Header holds the magic string and nine words, node records hold type,
+// opcode, value, three sons and negation of a node.
+static const size_t   headerSize    = sizeof(cacheMagic) + 9 * sizeof(uint32_t);
+static const size_t   recordSize    = 7 * sizeof(uint32_t);
+
+
+/** Word is appended to a buffer, in native byte order.
+ * @param[in,out] buffer   Buffer to be extended
+ * @param[in]  word        Word to be appended
  */
-AST::AST(StmType type)
+static void put(string &buffer, uint32_t word)
 {
-  switch(type){
-    case Skp:
-      this->nodeID  = ++AST::lastID;
-      this->type    = Stm;
-      this->parent  = NULL;
-      this->opcode.statement = type;
-      break;
-    default:
-      cerr << "[AST]: Wrong statement type." << endl;
-  }
+  buffer.append((const char *) &word, sizeof(word));
 }
 
 
-/** Constructor of a unary statement abstract syntax node.
- * Unary statements are: print (Prn), input (In).
- * @param[in]  type        Type of the stament
- * @param[in]  first       Subtree representing the argument
+/** Word is read from a buffer, in native byte order.
+ * @param[in,out] data     Position in the buffer, moved past the word
+ * @retval     uint32_t    Word which was read
  */
-AST::AST(StmType type, AST *first)
+static uint32_t get(const char *&data)
 {
-  switch(type){
-    case Prn:
-    case In:
-      this->nodeID  = ++AST::lastID;
-      this->type    = Stm;
-      this->parent  = NULL;
-      this->sons.push_back(first);
-      this->opcode.statement = type;
-      first->parent = this;
-      break;
-    default:
-      cerr << "[AST]: Wrong statement type." << endl;
-  }
+  uint32_t word;
+
+  memcpy(&word, data, sizeof(word));
+  data += sizeof(word);
+  return word;
 }
 
 
-/** Constructor of a binary statement abstract syntax node.
- * Binary statements are: assignment (Asn), sequential composition
- * (Seq), while loop (Whl).
- * @param[in]  type        Type of the statement
- * @param[in]  first       Subtree representing the first argument
- * @param[in]  second      Subtree representing the second argument
+/** Constructor of an empty abstract syntax tree.
+ * Nodes are added through the node() methods, and the root is set
+ * through setRoot().
  */
-AST::AST(StmType type, AST *first, AST *second)
+AST::AST()
+{
+  root = None;
+  strategy.delay     = 0;
+  strategy.narrowing = 0;
+  strategy.budget    = 0;
+}
+
+
+/** Destructor of an abstract syntax tree.
+ * Every node lives in the same arena, which is freed in one shot.
+ */
+AST::~AST()
 {
-  switch(type){
-    case Asn:
-    case Seq:
-    case Whl:
-      this->nodeID  = ++AST::lastID;
-      this->type    = Stm;
-      this->parent  = NULL;
-      this->sons.push_back(first);
-      this->sons.push_back(second);
-      this->opcode.statement = type;
-      first->parent = this;
-      second->parent= this;
-      break;
-    default:
-      cerr << "[AST]: Wrong statement type." << endl;
-  }
 }
 
 
-/** Constructor of a ternary statement abstract syntax node.
+/** Constructor of a statement abstract syntax node.
+ * 0-ary statements are: skip (Skp).
+ * Unary statements are: print (Prn), input (In), block (Blk), whose
+ * argument is its first statement, if any.
+ * Binary statements are: assignment (Asn), while loop (Whl).
  * Ternary statements are: if-then-else branch (If).
  * @param[in]  type        Type of the statement
  * @param[in]  first       Subtree representing the first argument
  * @param[in]  second      Subtree representing the second argument
  * @param[in]  third       Subtree representing the third argument
+ * @retval     Index       Index of the new node
  */
-AST::AST(StmType type, AST *first, AST *second, AST *third)
+AST::Index AST::node(StmType type, Index first, Index second, Index third)
 {
   switch(type){
+    case Skp:
+    case Prn:
+    case In:
+    case Asn:
+    case Whl:
     case If:
-      this->nodeID  = ++AST::lastID;
-      this->type    = Stm;
-      this->parent  = NULL;
-      this->sons.push_back(first);
-      this->sons.push_back(second);
-      this->sons.push_back(third);
-      this->opcode.statement = type;
-      first->parent = this;
-      second->parent= this;
-      third->parent = this;
+      append(Stm, first, second, third).opcode.statement = type;
       break;
+    case Blk:
+    {
+      Node &node = append(Stm);
+      node.opcode.statement = type;
+      node.value.block = sequences.size();
+      sequences.push_back(vector<Index>());
+      if(first != None){ push(nodes.size() - 1, first); }
+      return nodes.size() - 1;
+    }
     default:
       cerr << "[AST]: Wrong statement type." << endl;
+      return None;
+  }
+
+  return nodes.size() - 1;
+}
+
+
+/** A statement is appended to a block.
+ * Statements of a nested block are appended one by one instead, so
+ * that blocks stay flat.
+ * @param[in]  block       Index of the block
+ * @param[in]  statement   Index of the statement
+ */
+void AST::push(Index block, Index statement)
+{
+  vector<Index> &sequence = sequences[nodes[block].value.block];
+  const Node &node = nodes[statement];
+
+  if(node.type == Stm && node.opcode.statement == Blk){
+    const vector<Index> &nested = sequences[node.value.block];
+    sequence.insert(sequence.end(), nested.begin(), nested.end());
+  }
+  else{
+    sequence.push_back(statement);
   }
 }
 
@@ -114,96 +163,105 @@ AST::AST(StmType type, AST *first, AST *second, AST *third)
  * Numeric constant expressions are: num (Num).
  * @param[in]  type        Type of the arithmetic expression
  * @param[in]  num         Constant, integer value
+ * @retval     Index       Index of the new node
  */
-AST::AST(AExpType type, int num)
+AST::Index AST::node(AExpType type, int num)
 {
   switch(type){
     case Num:
-      this->nodeID  = ++AST::lastID;
-      this->type    = AExp;
-      this->parent  = NULL;
-      this->value.num = num;
-      this->opcode.arithmetic = type;
+    {
+      Node &node = append(AExp);
+      node.opcode.arithmetic = type;
+      node.value.num = num;
       break;
+    }
     default:
       cerr << "[AST]: Wrong arithmetic type." << endl;
+      return None;
   }
+
+  return nodes.size() - 1;
 }
 
 
 /** Constructor of a variable synatax node.
- * Varibales are: var (Var).
+ * Varibales are: var (Var). Identifiers are interned, so that every
+ * node refers to an entry of the symbol table instead of holding a
+ * copy of the name.
  * @param[in]  type        Type of the arithmetic expression
  * @param[in]  var         Name of the variable
+ * @retval     Index       Index of the new node
  */
-AST::AST(AExpType type, string var)
+AST::Index AST::node(AExpType type, const char *var)
 {
-  switch(type){
-    case Var:
-      this->nodeID  = ++AST::lastID;
-      this->type    = AExp;
-      this->parent  = NULL;
-      this->value.var = new string(var);
-      this->opcode.arithmetic = type;
-      break;
-    default:
-      cerr << "[AST]: Wrong arithmetic type." << endl;
-  }
+  return node(type, var, strlen(var));
 }
 
 
-/** Constructor of an unary arithmetic expression abstract syntax node.
- * Unary arithmetic expressions are: identity (Id), opposite (Opp).
+/** Constructor of a variable synatax node from a lexeme.
+ * Name needs not to be terminated, so that the parser can refer to
+ * the source code instead of copying it.
  * @param[in]  type        Type of the arithmetic expression
- * @param[in]  a           Operand
+ * @param[in]  var         Name of the variable
+ * @param[in]  length      Length of the name
+ * @retval     Index       Index of the new node
  */
-AST::AST(AExpType type, AST *a)
+AST::Index AST::node(AExpType type, const char *var, size_t length)
 {
+  map<string, unsigned int, less<> >::iterator it;
+  string_view name(var, length);
+
   switch(type){
-    case Id:
-    case Opp:
-      this->nodeID  = ++AST::lastID;
-      this->type    = AExp;
-      this->parent  = NULL;
-      this->sons.push_back(a);
-      this->opcode.arithmetic = type;
-      a->parent     = this;
+    case Var:
+    {
+      it = identifiers.find(name);
+      if(it == identifiers.end()){
+        it = identifiers.emplace(string(name), symbols.size()).first;
+        symbols.push_back(string(name));
+      }
+      Node &node = append(AExp);
+      node.opcode.arithmetic = type;
+      node.value.var = it->second;
       break;
+    }
     default:
       cerr << "[AST]: Wrong arithmetic type." << endl;
+      return None;
   }
+
+  return nodes.size() - 1;
 }
 
 
-/** Constructor of a binary arithmetic expression abstract syntax node.
+/** Constructor of an arithmetic expression abstract syntax node.
+ * Unary arithmetic expressions are: identity (Id), opposite (Opp).
  * Binary arithmetic expressions are: sum (Sum), subtraction (Sub),
  * multiplication (Mul), integer division (Div), remainder of the
  * integer division (Rem), raise to the power (Pow).
  * @param[in]  type        Type of the arithmetic expression
  * @param[in]  a1          First operand
- * @param[in]  a2          Second operand
+ * @param[in]  a2          Second operand, if any
+ * @retval     Index       Index of the new node
  */
-AST::AST(AExpType type, AST *a1, AST *a2)
+AST::Index AST::node(AExpType type, Index a1, Index a2)
 {
   switch(type){
+    case Id:
+    case Opp:
     case Sum:
     case Sub:
     case Mul:
     case Div:
     case Rem:
     case Pow:
-      this->nodeID  = ++AST::lastID;
-      this->type    = AExp;
-      this->parent  = NULL;
-      this->sons.push_back(a1);
-      this->sons.push_back(a2);
-      this->opcode.arithmetic = type;
-      a1->parent     = this;
-      a2->parent     = this;
+      append(AExp, a1, a2).opcode.arithmetic = type;
       break;
     default:
       cerr << "[AST]: Wrong arithmetic type." << endl;
+      return None;
   }
+
+  return nodes.size() - 1;
 }
 
 
@@ -211,46 +269,29 @@ AST::AST(AExpType type, AST *a1, AST *a2)
  * Constant, boolean values are: boolean (Bool).
  * @param[in]  type        Type of the boolean value
  * @param[in]  boolean     Boolean value
+ * @retval     Index       Index of the new node
  */
-AST::AST(BExpType type, bool boolean)
+AST::Index AST::node(BExpType type, bool boolean)
 {
   switch(type){
     case Bool:
-      this->nodeID  = ++AST::lastID;
-      this->type    = BExp;
-      this->parent  = NULL;
-      this->opcode.boolean = type;
-      this->value.boolean  = boolean;
+    {
+      Node &node = append(BExp);
+      node.opcode.boolean = type;
+      node.value.boolean  = boolean;
       break;
+    }
     default:
       cerr << "[AST]: Wrong boolear type." << endl;
+      return None;
   }
-}
-
 
-/** Constructor of a unary boolean expression abstract syntax node.
- * Unary boolean expressions are: logical negation (Not).
- * @param[in]  type        Type of the boolean expression
- * @param[in]  b           Operand
- */
-AST::AST(BExpType type, AST *b)
-{
-  switch(type){
-    case Not:
-      this->nodeID  = ++AST::lastID;
-      this->type    = BExp;
-      this->parent  = NULL;
-      this->sons.push_back(b);
-      this->opcode.boolean = type;
-      b->parent     = this;
-      break;
-    default:
-      cerr << "[AST]: Wrong boolear type." << endl;
-  }
+  return negate(nodes.size() - 1);
 }
 
 
-/** Constructor of a binary boolean expression abstract syntax node.
+/** Constructor of a boolean expression abstract syntax node.
+ * Unary boolean expressions are: logical negation (Not).
  * Binary boolean expressions are: logical conjunction (And), logical
  * disjunction (Or), logical exclusive disjunction (Xor), negated
  * conjunction (Nand), negated disjunction (Nor), negated exclusive
@@ -259,11 +300,13 @@ AST::AST(BExpType type, AST *b)
  * to' comparison, 'greater than' comparison, 'not equal to' comparison.
  * @param[in]  type        Type of the boolean expression
  * @param[in]  b1          First operand
- * @param[in]  b2          Second operand
+ * @param[in]  b2          Second operand, if any
+ * @retval     Index       Index of the new node
  */
-AST::AST(BExpType type, AST *b1, AST *b2)
+AST::Index AST::node(BExpType type, Index b1, Index b2)
 {
   switch(type){
+    case Not:
     case And:
     case Or:
     case Xor:
@@ -276,64 +319,174 @@ AST::AST(BExpType type, AST *b1, AST *b2)
     case Geq:
     case Gt:
     case Neq:
-      this->nodeID  = ++AST::lastID;
-      this->type    = BExp;
-      this->parent  = NULL;
-      this->sons.push_back(b1);
-      this->sons.push_back(b2);
-      this->opcode.boolean = type;
-      b1->parent    = this;
-      b2->parent    = this;
+      append(BExp, b1, b2).opcode.boolean = type;
       break;
     default:
       cerr << "[AST]: Wrong boolean type." << endl;
+      return None;
   }
+
+  return negate(nodes.size() - 1);
 }
 
 
-/** Destructor of an abstract syntax tree. */
-AST::~AST()
+/** Root of the abstract syntax tree is set.
+ * @param[in]  root        Index of the root node
+ */
+void AST::setRoot(Index root)
+{
+  this->root = root;
+}
+
+
+/** Number of nodes in the arena is returned.
+ * @retval     size_t      Number of nodes
+ */
+size_t AST::size() const
+{
+  return nodes.size();
+}
+
+
+/** Symbol resolution pass.
+ * Every distinct identifier is assigned a dense slot, so that
+ * variables can be accessed by index instead of by name. Slots follow
+ * the alphabetical order of names.
+ */
+void AST::resolve()
+{
+  map<string, unsigned int, less<> >::iterator it;
+  vector<unsigned int> slot(symbols.size());
+  vector<Node>::iterator node;
+
+  // Identifiers were interned in order of appearance: they are
+  // renumbered in alphabetical order.
+  symbols.clear();
+  for(it = identifiers.begin(); it != identifiers.end(); ++it){
+    slot[it->second] = symbols.size();
+    it->second = symbols.size();
+    symbols.push_back(it->first);
+  }
+
+  for(node = nodes.begin(); node != nodes.end(); ++node){
+    if(node->type == AExp && node->opcode.arithmetic == Var){
+      node->value.var = slot[node->value.var];
+    }
+  }
+}
+
+
+/** Optimization pass.
+ * Constant subexpressions are folded, algebraic identities are
+ * simplified and branches decided by a constant guard are pruned, so
+ * that every engine evaluates a smaller tree. Nodes which are no
+ * longer reachable are left in the arena.
+ */
+void AST::optimize()
+{
+  root = optimize(root);
+}
+
+
+/** Liveness analysis.
+ * Variables which die at each statement, at each guard and at the end
+ * of each loop are computed backwards, so that interpret() drops their
+ * bindings and states only hold live variables. Only the given
+ * variables are live at the end of the program, the others are not
+ * kept for the final state.
+ * @param[in]  observed    Name of the variables live at the end
+ */
+void AST::liveness(const vector<string> &observed)
+{
+  map<string, unsigned int, less<> >::iterator it;
+  vector<bool> live(symbols.size(), false);
+  unsigned int i;
+
+  for(i = 0; i < observed.size(); ++i){
+    it = identifiers.find(observed[i]);
+    if(it != identifiers.end()){ live[it->second] = true; }
+  }
+
+  dead.assign(nodes.size(), vector<unsigned int>());
+  if(root != None){ liveness(root, live); }
+}
+
+
+/** Symbol table built by the resolution pass is returned.
+ * @retval     vector<string> * Name of the variable in each slot
+ */
+const vector<string> *AST::variables() const
+{
+  return &symbols;
+}
+
+
+/** Constants of the program are returned.
+ * Every constant is returned together with its neighbours, so that
+ * both strict and non strict comparisons can be used as widening
+ * thresholds. Only the nodes reachable from the root are considered.
+ * @retval     vector<long> Constants, in no particular order
+ */
+vector<long> AST::constants() const
 {
-  vector<AST*>::iterator it;
-  
-  // If node contains an identifier, it is deallocated.
-  if(type == AExp && opcode.arithmetic == Var){
-    delete value.var;
-  }
-  
-  // Every sub-tree rooted in the current node is destroied.
-  for(it = sons.begin(); it != sons.end(); ++it){
-    if((*it)->parent == this){
-      delete *it;
+  vector<long> constants;
+  vector<Index> nodeStack;
+
+  if(root != None){ nodeStack.push_back(root); }
+  while(!nodeStack.empty()){
+    Index n = nodeStack.back();
+    const Node &node = nodes[n];
+    nodeStack.pop_back();
+
+    if(node.type == AExp && node.opcode.arithmetic == Num){
+      constants.push_back((long) node.value.num - 1);
+      constants.push_back((long) node.value.num);
+      constants.push_back((long) node.value.num + 1);
     }
+    sons(n, nodeStack);
   }
+
+  return constants;
+}
+
+
+/** Iteration strategy of loops is set.
+ * By default loops are widened from the first iteration, are not
+ * narrowed and have no limit on iterations.
+ * @param[in]  strategy    Iteration strategy
+ */
+void AST::setStrategy(const Strategy &strategy)
+{
+  this->strategy = strategy;
 }
 
 
-/** A textual representation of the node is provided.
+/** A textual representation of a node is provided.
+ * @param[in]  n           Index of the node
  * @retval     string      String representing the node
  */
-string AST::toString()
+string AST::toString(Index n) const
 {
+  const Node &node = nodes[n];
   char str[32];
-  
-  switch(type){
-    case Stm: switch(opcode.statement){
+
+  switch(node.type){
+    case Stm: switch(node.opcode.statement){
       case Asn: return ":=";
       case Skp: return "skip";
-      case Seq: return ";";
+      case Blk: return "block";
       case If:  return "if-then-else";
       case Whl: return "while";
       case Prn: return "print";
       case In:  return "input";
       default:  return "Unrecognized\\nstatement";
     }
-    
-    case AExp: switch(opcode.arithmetic){
+
+    case AExp: switch(node.opcode.arithmetic){
       case Num:
-        sprintf(str, "Num\\n%d", value.num);
+        sprintf(str, "Num\\n%d", node.value.num);
         return str;
-      case Var: return "Var\\n" + *(value.var);
+      case Var: return "Var\\n" + symbols[node.value.var];
       case Id:  return "AExp\\n+";
       case Opp: return "AExp\\n-";
       case Sum: return "AExp\\n+";
@@ -344,11 +497,12 @@ string AST::toString()
       case Pow: return "AExp\\n^";
       default:  return "Unrecognized\\narithmetic expression";
     }
-    
-    case BExp: switch(opcode.boolean){
+
+    case BExp: switch(node.opcode.boolean){
       case Bool:
-        sprintf(str, "Bool\\n%s", value.boolean ? "true" : "false");
+        sprintf(str, "Bool\\n%s", node.value.boolean ? "true" : "false");
         return str;
+      case Not: return "BExp\\nnot";
       case And: return "BExp\\nand";
       case Or:  return "BExp\\nor";
       case Xor: return "BExp\\nxor";
@@ -363,7 +517,7 @@ string AST::toString()
       case Neq: return "BExp\\n<>";
       default:  return "Unrecognized\\nboolean expression";
     }
-    
+
     default:
       return "Unrecognized node type.";
   }
@@ -371,16 +525,16 @@ string AST::toString()
 
 
 /** Abstract syntax tree is exported to graphviz.
- * The abstract syntax tree rooted in the current node is esported
- * into a file which can later be compiled using graphviz.
+ * The abstract syntax tree is esported into a file which can later be
+ * compiled using graphviz.
  * @param[in]  filename      Path to the output file
  */
-void AST::toGraphviz(const char *filename)
+void AST::toGraphviz(const char *filename) const
 {
   ofstream output;
-  vector<AST *> nodeStack;
-  vector<AST *>::iterator rit;
-  
+  vector<Index> nodeStack;
+  size_t i;
+
   // Output file is open.
   output.open(filename);
   if(!output.is_open()){
@@ -388,7 +542,7 @@ void AST::toGraphviz(const char *filename)
          << filename << "." << endl;
     return;
   }
-  
+
   // Graphviz header is written.
   output
   << "/** Automatically generated by While for Graphviz.\n"
@@ -416,128 +570,292 @@ void AST::toGraphviz(const char *filename)
   << "  "                           << endl
   << "  /* Nodes and arcs. */"      << endl
   ;
-  
+
   // Every node and arc are written trhough a in-depth visit.
-  nodeStack.push_back(this);
+  if(root != None){ nodeStack.push_back(root); }
   while(!nodeStack.empty()){
-    AST *node = nodeStack.back();
+    Index n = nodeStack.back();
     nodeStack.pop_back();
-    vector<AST*> sons = node->sons;
     string label;
-    
+
     // Current node is visited.
-    label = "\"" + node->toString() + "\"";
-    output << "  " << node->nodeID << "[label=" << label << "]" << endl;
-    
+    label = "\"" + toString(n) + "\"";
+    output << "  " << n << "[label=" << label << "]" << endl;
+
     // Arcs exiting form the current node are written, and sons of the
     // current node are pushed into the stack to be visited.
-    for(rit = sons.begin(); rit != sons.end(); ++rit){
-      nodeStack.push_back(*rit);
-      output << "  " << node->nodeID << "->" << (*rit)->nodeID << endl;
+    i = nodeStack.size();
+    sons(n, nodeStack);
+    for(; i < nodeStack.size(); ++i){
+      output << "  " << n << "->" << nodeStack[i] << endl;
     }
   }
-  
+
   // Output file is closed.
   output << "}" << endl;
   output.close();
 }
 
 
+/** Abstract syntax tree is saved into a binary cache file.
+ * Only the nodes reachable from the root are written, renumbered
+ * densely, so that the tree can be analyzed again without scanning,
+ * parsing, resolving and optimizing the source code. The file holds,
+ * in native byte order and with no padding: a header (magic, version,
+ * byte order mark, size of a node record and the counts below), the
+ * nodes as words (type, opcode, value, three sons and negation), the
+ * offset of the statements of each block, the statements of every
+ * block and the names of the variables, terminated by '\0', in slot
+ * order.
+ * @param[in]  filename    Path to the output file
+ * @retval     bool        True if the file was written
+ */
+bool AST::save(const char *filename) const
+{
+  vector<Index> renumber(nodes.size(), None), order, nodeStack;
+  vector<Index> offsets(1, 0), statements;
+  ofstream output;
+  string buffer, names;
+  uint32_t block = 0, value;
+  size_t i, j;
+
+  // Reachable nodes are numbered in order of visit, negations included.
+  if(root != None){ nodeStack.push_back(root); }
+  while(!nodeStack.empty()){
+    Index n = nodeStack.back();
+    nodeStack.pop_back();
+    if(renumber[n] != None){ continue; }
+
+    renumber[n] = order.size();
+    order.push_back(n);
+    sons(n, nodeStack);
+    if(nodes[n].negation != None){ nodeStack.push_back(nodes[n].negation); }
+  }
+
+  // Blocks are numbered in order of visit, with their statements.
+  for(i = 0; i < order.size(); ++i){
+    const Node &node = nodes[order[i]];
+
+    if(node.type == Stm && node.opcode.statement == Blk){
+      const vector<Index> &sequence = sequences[node.value.block];
+      for(j = 0; j < sequence.size(); ++j){
+        statements.push_back(renumber[sequence[j]]);
+      }
+      offsets.push_back(statements.size());
+    }
+  }
+
+  for(i = 0; i < symbols.size(); ++i){
+    names.append(symbols[i]);
+    names.push_back('\0');
+  }
+
+  // Header is written word by word.
+  buffer.append(cacheMagic, sizeof(cacheMagic));
+  put(buffer, cacheVersion);
+  put(buffer, cacheOrder);
+  put(buffer, recordSize);
+  put(buffer, order.size());
+  put(buffer, (root == None) ? None : renumber[root]);
+  put(buffer, offsets.size() - 1);
+  put(buffer, statements.size());
+  put(buffer, symbols.size());
+  put(buffer, names.size());
+
+  // Nodes are written field by field, with their links renumbered. Only
+  // the member of the value which is in use is written.
+  for(i = 0; i < order.size(); ++i){
+    const Node &node = nodes[order[i]];
+
+    value = 0;
+    if(node.type == Stm){
+      put(buffer, Stm);
+      put(buffer, node.opcode.statement);
+      if(node.opcode.statement == Blk){ value = block++; }
+    }
+    else if(node.type == AExp){
+      put(buffer, AExp);
+      put(buffer, node.opcode.arithmetic);
+      if(node.opcode.arithmetic == Num){ value = (uint32_t) node.value.num; }
+      if(node.opcode.arithmetic == Var){ value = node.value.var; }
+    }
+    else{
+      put(buffer, BExp);
+      put(buffer, node.opcode.boolean);
+      if(node.opcode.boolean == Bool){ value = node.value.boolean ? 1 : 0; }
+    }
+    put(buffer, value);
+    for(j = 0; j < 3; ++j){
+      put(buffer, (node.sons[j] == None) ? None : renumber[node.sons[j]]);
+    }
+    put(buffer, (node.negation == None) ? None : renumber[node.negation]);
+  }
+
+  // Blocks, statements and names follow.
+  for(i = 0; i < offsets.size(); ++i){ put(buffer, offsets[i]); }
+  for(i = 0; i < statements.size(); ++i){ put(buffer, statements[i]); }
+  buffer.append(names);
+
+  output.open(filename, ios::out | ios::binary | ios::trunc);
+  if(!output.is_open()){
+    cerr << "[AST::save] Error while opening file: " << filename << "."
+         << endl;
+    return false;
+  }
+  output.write(buffer.data(), buffer.size());
+  output.close();
+
+  return !output.fail();
+}
+
+
+/** Abstract syntax tree is loaded from a binary cache file.
+ * File is mapped in memory and checked, so that a stale or corrupted
+ * cache is rejected instead of being analyzed. Tree is already
+ * resolved and optimized.
+ * @param[in]  filename    Path to the cache file, written by save()
+ * @retval     AST *       Abstract syntax tree, owned by the caller,
+ *                         NULL if the file could not be loaded
+ */
+AST *AST::load(const char *filename)
+{
+  struct stat status;
+  void *mapped = MAP_FAILED;
+  int file;
+  AST *tree;
+
+  file = open(filename, O_RDONLY);
+  if(file < 0 || fstat(file, &status) != 0){
+    cerr << "[AST::load] Error while opening file: " << filename << "."
+         << endl;
+    if(file >= 0){ close(file); }
+    return NULL;
+  }
+  if((size_t) status.st_size >= headerSize){
+    mapped = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  }
+  close(file);
+
+  tree = new AST();
+  if(mapped == MAP_FAILED
+     || !tree->restore((const char *) mapped, status.st_size)){
+    cerr << "[AST::load] Not a valid cache for this version: " << filename
+         << "." << endl;
+    delete tree;
+    tree = NULL;
+  }
+  if(mapped != MAP_FAILED){ munmap(mapped, status.st_size); }
+
+  return tree;
+}
+
+
 /** Concrete excecution is performed starting from the bottom state.
  * @retval     AbstractState State containing the result of the
  *                         (concrete) compupation
  */
-AbstractState<int> AST::execute()
+AbstractState<int> AST::execute() const
 {
-  return execute(AbstractState<int>());
+  AbstractState<int> state(&symbols);
+
+  execute(root, state);
+  return state;
 }
 
 
 /** Concrete excecution is performed starting from the given state.
- * @retval     AbstractState State containing the result of the
- *                         (concrete) compupation
+ * @param[in]  n           Index of the statement to be executed
+ * @param[in,out] state    Initial state, replaced by the final one
  */
-AbstractState<int> AST::execute(AbstractState<int> state)
+void AST::execute(Index n, AbstractState<int> &state) const
 {
+  const Node &node = nodes[n];
+  size_t i;
   int input;
-  
-  // If node is not a statement, just return the curren state.
-  if(type != Stm){ return state; }
-  
+
+  // If node is not a statement, just keep the current state.
+  if(node.type != Stm){ return; }
+
   // Correct action is taken depending on the statement type.
-  switch(opcode.statement){
+  switch(node.opcode.statement){
     case Asn:
-      state.store(*(sons[0]->value.var), sons[1]->A(state));
-      return state;
-    
+      state.store(nodes[node.sons[0]].value.var, A(node.sons[1], state));
+      return;
+
     case Skp:
-      return state;
-    
-    case Seq:
-      return sons[1]->execute(sons[0]->execute(state));
-    
+      return;
+
+    case Blk:
+      for(i = 0; i < sequences[node.value.block].size(); ++i){
+        execute(sequences[node.value.block][i], state);
+      }
+      return;
+
     case If:
-      return sons[0]->B(state)
-           ? sons[1]->execute(state)
-           : sons[2]->execute(state);
-    
+      if(B(node.sons[0], state)){ execute(node.sons[1], state); }
+      else{                       execute(node.sons[2], state); }
+      return;
+
     case Whl:
-      while(sons[0]->B(state)){
-        state = sons[1]->execute(state);
+      while(B(node.sons[0], state)){
+        execute(node.sons[1], state);
       }
-      return state;
-    
+      return;
+
     case Prn:
-      cout << (sons[0]->A(state)) << endl;
-      return state;
-    
+      cout << A(node.sons[0], state) << endl;
+      return;
+
     case In:
-      cout << "> " << *(sons[0]->value.var) << " := ";
+      cout << "> " << symbols[nodes[node.sons[0]].value.var] << " := ";
       cin >> input;
-      state.store(*(sons[0]->value.var), input);
-      return state;
-    
+      state.store(nodes[node.sons[0]].value.var, input);
+      return;
+
     default:
       cerr << "[AST::execute]: Unrecognized statement opcode value: "
-           << opcode.statement << "." << endl;
-      return AbstractState<int>();
+           << node.opcode.statement << "." << endl;
+      state.clear();
   }
 }
 
 
 /** An arithmetic expression is evaluated in the given state.
  * Evaluation is performed on the concrete values.
+ * @param[in]  n           Index of the expression to be evaluated
  * @param[in]  state       Concrete state where expression is
  *                         evaluated
  * @retval     int         Evaluated arithmetic expression
  */
-int AST::A(AbstractState<int> state)
+int AST::A(Index n, const AbstractState<int> &state) const
 {
+  const Node &node = nodes[n];
+  const Index *sons = node.sons;
   int i, pow;
-  
+
   // If node is not an arithmetic expression, just return 0.
-  if(type != AExp){ return 0; }
-  
+  if(node.type != AExp){ return 0; }
+
   // Correct action is taked depending on the type of operation.
-  switch(opcode.arithmetic){
-    case Num: return value.num;
-    case Var: return state.load(*(value.var));
-    case Id:  return sons[0]->A(state);
-    case Opp: return -(sons[0]->A(state));
-    case Sum: return sons[0]->A(state) + sons[1]->A(state);
-    case Sub: return sons[0]->A(state) - sons[1]->A(state);
-    case Mul: return sons[0]->A(state) * sons[1]->A(state);
-    case Div: return sons[0]->A(state) / sons[1]->A(state);
-    case Rem: return sons[0]->A(state) % sons[1]->A(state);
+  switch(node.opcode.arithmetic){
+    case Num: return node.value.num;
+    case Var: return state.load(node.value.var);
+    case Id:  return A(sons[0], state);
+    case Opp: return -A(sons[0], state);
+    case Sum: return A(sons[0], state) + A(sons[1], state);
+    case Sub: return A(sons[0], state) - A(sons[1], state);
+    case Mul: return A(sons[0], state) * A(sons[1], state);
+    case Div: return A(sons[0], state) / A(sons[1], state);
+    case Rem: return A(sons[0], state) % A(sons[1], state);
     case Pow:
       pow = 1;
-      for(i = 0; i < sons[1]->A(state); ++i){
-        pow *= sons[0]->A(state);
+      for(i = 0; i < A(sons[1], state); ++i){
+        pow *= A(sons[0], state);
       }
       return pow;
     default:
       cerr << "[AST::A]: Unrecognized arithmetic opcode value: "
-           << opcode.statement << "." << endl;
+           << node.opcode.arithmetic << "." << endl;
       return 0;
   }
 }
@@ -545,109 +863,1067 @@ int AST::A(AbstractState<int> state)
 
 /** Boolean expression is evaluated in the given state.
  * Evaluation is perfomed on the concrete values.
+ * @param[in]  n           Index of the expression to be evaluated
  * @param[in]  state       Initial state
  * @retval     bool        True if and only if the boolean expression
  *                         evaluates to true
  */
-bool AST::B(AbstractState<int> state)
+bool AST::B(Index n, const AbstractState<int> &state) const
 {
+  const Node &node = nodes[n];
+  const Index *sons = node.sons;
+
   // If node is not a boolean expression, just return false.
-  if(type != BExp){ return false; }
-  
+  if(node.type != BExp){ return false; }
+
   // Correct action is taked depending on the type of expression.
-  switch(this->opcode.boolean)
+  switch(node.opcode.boolean)
   {
-    case Bool: return value.boolean;
-    case Not:  return !(sons[0]->B(state));
-    
-    case Lt:   return sons[0]->A(state) <  sons[1]->A(state);
-    case Leq:  return sons[0]->A(state) <= sons[1]->A(state);
-    case Eq:   return sons[0]->A(state) == sons[1]->A(state);
-    case Geq:  return sons[0]->A(state) >= sons[1]->A(state);
-    case Gt:   return sons[0]->A(state) >  sons[1]->A(state);
-    case Neq:  return sons[0]->A(state) != sons[1]->A(state);
-    
-    case And:  return sons[0]->B(state) && sons[1]->B(state);
-    case Or:   return sons[0]->B(state) || sons[1]->B(state);
-    case Xor:
-      return (!(sons[0]->B(state)) && sons[1]->B(state))
-          || (sons[0]->B(state) && !(sons[1]->B(state)));
-    case Nand: return !(sons[0]->B(state) && sons[1]->B(state));
-    case Nor:  return !(sons[0]->B(state) || sons[1]->B(state));
-    case Xnor:
-      return !((!(sons[0]->B(state)) && sons[1]->B(state))
-          || (sons[0]->B(state) && !(sons[1]->B(state))));
+    case Bool: return node.value.boolean;
+    case Not:  return !B(sons[0], state);
+
+    case Lt:   return A(sons[0], state) <  A(sons[1], state);
+    case Leq:  return A(sons[0], state) <= A(sons[1], state);
+    case Eq:   return A(sons[0], state) == A(sons[1], state);
+    case Geq:  return A(sons[0], state) >= A(sons[1], state);
+    case Gt:   return A(sons[0], state) >  A(sons[1], state);
+    case Neq:  return A(sons[0], state) != A(sons[1], state);
+
+    case And:  return B(sons[0], state) && B(sons[1], state);
+    case Or:   return B(sons[0], state) || B(sons[1], state);
+    case Xor:  return B(sons[0], state) != B(sons[1], state);
+    case Nand: return !(B(sons[0], state) && B(sons[1], state));
+    case Nor:  return !(B(sons[0], state) || B(sons[1], state));
+    case Xnor: return B(sons[0], state) == B(sons[1], state);
     default:
       cerr << "[AST::B]: Unrecognized boolean opcode value: "
-           << opcode.statement << "." << endl;
+           << node.opcode.boolean << "." << endl;
       return false;
   }
 }
 
 
-unsigned int AST::lastID = 0;
+/** Interval with the given bounds is built.
+ * @param[in]  lower       Lower bound, the limit of long if missing
+ * @param[in]  upper       Upper bound, the limit of long if missing
+ * @retval     Interval    Interval between the bounds, bottom if empty
+ */
+static Interval interval(long lower, long upper)
+{
+  Interval i = Interval::top();
+
+  i.meet(lower, upper);
+  return i;
+}
+
+
+/** An assignment or an input statement is interpreted over zones.
+ * @param[in]  n           Index of the statement
+ * @param[in,out] state    State to be updated
+ */
+void AST::assign(Index n, AbstractState<Zone> &state) const
+{
+  assignRelational(n, state);
+}
 
 
-/** Boolean expression is negated.
- * Boolean expression associated to the current node is reversed and
- * returned into a new sub-tree.
- * For instance, if current node contains a 'less than' comparison
- * between arithmetic expressions a1 and a2, a new sub-tree is created,
- * whose root is a node representing a 'greater than or equal to'
- * comparison between a1 and a2.
- * @retval     AST         Negated boolean expression
+/** An assignment or an input statement is interpreted over octagons.
+ * @param[in]  n           Index of the statement
+ * @param[in,out] state    State to be updated
  */
-AST AST::neg()
+void AST::assign(Index n, AbstractState<Octagon> &state) const
 {
-  BExpType notOpcode;
-  AST falseBExp = AST(Bool, false);
-  
-  // If node is not a boolean expression, just return a constant false
-  // node.
-  if(type != BExp){ return falseBExp; }
-  
-  // New opcode is detected.
-  switch(opcode.boolean){
-    case Bool: notOpcode = Bool; break;
-    case Not:  notOpcode = Not;  break;
-    case Lt:   notOpcode = Geq;  break;
-    case Leq:  notOpcode = Gt;   break;
-    case Eq:   notOpcode = Neq;  break;
-    case Geq:  notOpcode = Lt;   break;
-    case Gt:   notOpcode = Leq;  break;
-    case Neq:  notOpcode = Eq;   break;
-    case And:  notOpcode = Nand; break;
-    case Or:   notOpcode = Nor;  break;
-    case Xor:  notOpcode = Xnor; break;
-    case Nand: notOpcode = And;  break;
-    case Nor:  notOpcode = Or;   break;
-    case Xnor: notOpcode = Xor;  break;
-    default:
-      cerr << "[AST::neg]: Unrecognized boolean opcode value: "
-           << opcode.arithmetic << "." << endl;
-      return falseBExp;
-  }
-  
-  
-  // A new sub-tree is created.
-  switch(notOpcode){
-    case Bool:
-      return AST(Bool, !value.boolean);
-    
-    case Not:
-      return sons[0]->neg();
-    
-    case Lt:   case Leq:  case Eq:   case Geq:  case Gt:   case Neq:
-    case And:  case Or:   case Xor:  case Nand: case Nor:  case Xnor:
-    {
-      AST negation = AST(notOpcode, sons[0], sons[1]);
-      sons[0]->parent = this;  sons[1]->parent = this;
-      return negation;
-    }
-    
-    default:
-      cerr << "[AST::neg]: Unrecognized boolean opcode value: "
-           << opcode.arithmetic << "." << endl;
-      return falseBExp;
+  assignRelational(n, state);
+}
+
+
+/** An assignment or an input statement is interpreted over a relational
+ * domain. Assignments of a variable, or of its opposite, plus a
+ * constant keep the relation between the variables, if the state can
+ * represent it; any other expression is evaluated over intervals.
+ * @param[in]  n           Index of the statement
+ * @param[in,out] state    State to be updated
+ */
+template <typename S>
+void AST::assignRelational(Index n, S &state) const
+{
+  const Node &node = nodes[n];
+  unsigned int var = nodes[node.sons[0]].value.var, other;
+  int sign;
+  long c, lower, upper;
+
+  if(node.opcode.statement == In){
+    state.assign(var, numeric_limits<long>::min(),
+                 numeric_limits<long>::max());
+    return;
+  }
+  if(linear(node.sons[1], other, sign, c)
+  && state.assign(var, sign, other, c)){
+    return;
   }
+  evaluate(node.sons[1], state, lower, upper);
+  if(lower > upper){ state.clear(); }
+  else{ state.assign(var, lower, upper); }
+}
+
+
+/** Comparison is evaluated over zones.
+ * @param[in]  node        Comparison to be evaluated
+ * @param[in,out] state    State to be filtered
+ */
+void AST::compare(const Node &node, AbstractState<Zone> &state) const
+{
+  compareRelational(node, state);
+}
+
+
+/** Comparison is evaluated over octagons.
+ * @param[in]  node        Comparison to be evaluated
+ * @param[in,out] state    State to be filtered
+ */
+void AST::compare(const Node &node, AbstractState<Octagon> &state) const
+{
+  compareRelational(node, state);
+}
+
+
+/** Comparison is evaluated over a relational domain.
+ * Comparisons between variables plus constants are added to the state
+ * as constraints, if the state can represent them; any other side is
+ * evaluated over intervals. Disequalities are only decided between
+ * constants.
+ * @param[in]  node        Comparison to be evaluated
+ * @param[in,out] state    State to be filtered
+ */
+template <typename S>
+void AST::compareRelational(const Node &node, S &state) const
+{
+  Index l = node.sons[0], r = node.sons[1];
+  long lLower, lUpper, rLower, rUpper;
+
+  switch(node.opcode.boolean){
+    case Lt:  lessEqual(l, r, -1, state); break;
+    case Leq: lessEqual(l, r,  0, state); break;
+    case Geq: lessEqual(r, l,  0, state); break;
+    case Gt:  lessEqual(r, l, -1, state); break;
+    case Eq:
+      lessEqual(l, r, 0, state);
+      lessEqual(r, l, 0, state);
+      break;
+    default:
+      evaluate(l, state, lLower, lUpper);
+      evaluate(r, state, rLower, rUpper);
+      if(lLower == lUpper && rLower == rUpper && lLower == rLower){
+        state.clear();
+      }
+      break;
+  }
+}
+
+
+/** Predicate testing whether an expression is a variable, or its
+ * opposite, plus a constant, such as y, -y, y + c, c - y or -(y - c).
+ * @param[in]  n           Index of the expression
+ * @param[out] var         Slot of the variable
+ * @param[out] sign        Sign of the variable, 1 or -1
+ * @param[out] c           Constant added to the variable
+ * @retval     bool        True if expression has one of such forms
+ */
+bool AST::linear(Index n, unsigned int &var, int &sign, long &c) const
+{
+  const Node &node = nodes[n];
+  Index a, b;
+
+  switch(node.opcode.arithmetic){
+    case Var:
+      var  = node.value.var;
+      sign = 1;
+      c    = 0;
+      return true;
+
+    case Id:
+      return linear(node.sons[0], var, sign, c);
+
+    case Opp:
+      if(!linear(node.sons[0], var, sign, c)){ return false; }
+      sign = -sign;
+      c    = -c;
+      return true;
+
+    case Sum:
+    case Sub:
+      a = node.sons[0];
+      b = node.sons[1];
+      if(nodes[b].opcode.arithmetic == Num){
+        if(!linear(a, var, sign, c)){ return false; }
+        c += (node.opcode.arithmetic == Sum) ? nodes[b].value.num
+                                             : -nodes[b].value.num;
+        return true;
+      }
+      if(nodes[a].opcode.arithmetic == Num){
+        if(!linear(b, var, sign, c)){ return false; }
+        if(node.opcode.arithmetic == Sub){
+          sign = -sign;
+          c    = -c;
+        }
+        c += nodes[a].value.num;
+        return true;
+      }
+      return false;
+
+    default:
+      return false;
+  }
+}
+
+
+/** An arithmetic expression is evaluated over intervals in a state over
+ * a relational domain.
+ * Missing bounds are represented by the limits of long. Sums and
+ * differences of two variables plus constants are bounded by the state
+ * itself, if it relates them.
+ * @param[in]  n           Index of the expression
+ * @param[in]  state       State over a relational domain
+ * @param[out] lower       Lower bound of the expression
+ * @param[out] upper       Upper bound of the expression
+ */
+template <typename S>
+void AST::evaluate(Index n, const S &state, long &lower, long &upper) const
+{
+  const long min = numeric_limits<long>::min();
+  const long max = numeric_limits<long>::max();
+  const Node &node = nodes[n];
+  unsigned int x, y;
+  int sx, sy;
+  long a, b;
+  Interval i, j, result;
+
+  switch(node.opcode.arithmetic){
+    case Num:
+      lower = upper = node.value.num;
+      return;
+    case Var:
+      state.bounds(node.value.var, lower, upper);
+      return;
+
+    // Sum of two variables is bounded by the state itself.
+    case Sum:
+    case Sub:
+      if(!linear(node.sons[0], x, sx, a) || !linear(node.sons[1], y, sy, b)){
+        break;
+      }
+      if(node.opcode.arithmetic == Sub){
+        sy = -sy;
+        b  = -b;
+      }
+      if(x == y && sx != sy){
+        lower = upper = a + b;
+        return;
+      }
+      if(x != y && state.range(sx, x, sy, y, lower, upper)){
+        if(lower != min){ lower += a + b; }
+        if(upper != max){ upper += a + b; }
+        return;
+      }
+      break;
+    default:
+      break;
+  }
+
+  evaluate(node.sons[0], state, lower, upper);
+  i = interval(lower, upper);
+  if(node.sons[1] != None){
+    evaluate(node.sons[1], state, lower, upper);
+    j = interval(lower, upper);
+  }
+
+  switch(node.opcode.arithmetic){
+    case Id:  result = +i;    break;
+    case Opp: result = -i;    break;
+    case Sum: result = i + j; break;
+    case Sub: result = i - j; break;
+    case Mul: result = i * j; break;
+    case Div: result = i / j; break;
+    case Rem: result = i % j; break;
+    case Pow: result = i ^ j; break;
+    default:  result = Interval::top(); break;
+  }
+  result.bounds(lower, upper);
+}
+
+
+/** Constraint l <= r + d is added to a state over a relational domain.
+ * If both sides are a variable, or its opposite, plus a constant, the
+ * constraint relates them, if the state can represent it. Otherwise,
+ * each side which is a variable is bounded by the interval of the other
+ * side, and if none is, only the intervals of the sides are compared.
+ * @param[in]  l           Index of the left expression
+ * @param[in]  r           Index of the right expression
+ * @param[in]  d           Constant added to the right expression
+ * @param[in,out] state    State to be filtered
+ */
+template <typename S>
+void AST::lessEqual(Index l, Index r, long d, S &state) const
+{
+  const long min = numeric_limits<long>::min();
+  const long max = numeric_limits<long>::max();
+  unsigned int x, y;
+  int sx, sy;
+  long a, b, k, lLower, lUpper, rLower, rUpper;
+  bool left, right;
+
+  if(state.isBottom()){ return; }
+  left  = linear(l, x, sx, a);
+  right = linear(r, y, sy, b);
+
+  // Both sides are related by the state: sx x - sy y <= b + d - a.
+  if(left && right){
+    k = b + d - a;
+    if(x == y && sx == sy){
+      if(k < 0){ state.clear(); }
+      return;
+    }
+    if(x == y){
+      if(sx > 0){ state.meet(x, min, (k >= 0) ? k / 2 : -((1 - k) / 2)); }
+      else{ state.meet(x, (k >= 0) ? -(k / 2) : (1 - k) / 2, max); }
+      return;
+    }
+    if(state.constrain(sx, x, -sy, y, k)){ return; }
+  }
+
+  evaluate(l, state, lLower, lUpper);
+  evaluate(r, state, rLower, rUpper);
+  if(lLower > lUpper || rLower > rUpper){
+    state.clear();
+    return;
+  }
+
+  // Variable on the left: sx x <= rUpper + d - a.
+  if(left && rUpper != max){
+    k = rUpper + d - a;
+    if(sx > 0){ state.meet(x, min, k); }
+    else{ state.meet(x, -k, max); }
+  }
+  // Variable on the right: sy y >= lLower - d - b.
+  if(right && lLower != min && !state.isBottom()){
+    k = lLower - d - b;
+    if(sy > 0){ state.meet(y, k, max); }
+    else{ state.meet(y, min, -k); }
+  }
+  if(!left && !right && lLower != min && rUpper != max && lLower > rUpper + d){
+    state.clear();
+  }
+}
+
+
+/** Variables of the program are partitioned into packs.
+ * Packs are the classes of a union-find over the slots, where the
+ * assigned variable is merged with the variable of its expression, and
+ * the variables of a comparison, or of a sum, are merged if both sides
+ * are a variable plus a constant: these are the only relations kept by
+ * relational domains. Only the nodes reachable from the root are
+ * considered.
+ * @retval     vector<unsigned int> Pack of the variable in each slot,
+ *                         packs being numbered from 0
+ */
+vector<unsigned int> AST::packs() const
+{
+  vector<unsigned int> parent(symbols.size()), packs(symbols.size());
+  vector<unsigned int> number(symbols.size(), 0);
+  vector<Index> nodeStack;
+  unsigned int i, x, y, count = 0;
+  int sign;
+  long c;
+
+  // Representative of a slot, halving paths along the way.
+  auto find = [&parent](unsigned int v){
+    while(parent[v] != v){
+      parent[v] = parent[parent[v]];
+      v = parent[v];
+    }
+    return v;
+  };
+
+  for(i = 0; i < parent.size(); ++i){ parent[i] = i; }
+  if(root != None){ nodeStack.push_back(root); }
+  while(!nodeStack.empty()){
+    Index n = nodeStack.back();
+    const Node &node = nodes[n];
+    nodeStack.pop_back();
+
+    if(node.type == Stm && node.opcode.statement == Asn
+    && linear(node.sons[1], y, sign, c)){
+      parent[find(nodes[node.sons[0]].value.var)] = find(y);
+    }
+    else if(((node.type == BExp && node.opcode.boolean >= Lt)
+          || (node.type == AExp && (node.opcode.arithmetic == Sum
+                                 || node.opcode.arithmetic == Sub)))
+         && linear(node.sons[0], x, sign, c)
+         && linear(node.sons[1], y, sign, c)){
+      parent[find(x)] = find(y);
+    }
+    sons(n, nodeStack);
+  }
+
+  // Packs are numbered in order of their first slot.
+  for(i = 0; i < parent.size(); ++i){
+    x = find(i);
+    if(number[x] == 0){ number[x] = ++count; }
+    packs[i] = number[x] - 1;
+  }
+
+  return packs;
+}
+
+
+/** A node is appended to the arena.
+ * @param[in]  type        Type of the node
+ * @param[in]  first       First son, if any
+ * @param[in]  second      Second son, if any
+ * @param[in]  third       Third son, if any
+ * @retval     Node &      Reference to the new node
+ */
+AST::Node &AST::append(nodeType type, Index first, Index second,
+                       Index third)
+{
+  Node node;
+
+  node.type      = type;
+  node.value.num = 0;
+  node.sons[0]   = first;
+  node.sons[1]   = second;
+  node.sons[2]   = third;
+  node.negation  = None;
+  nodes.push_back(node);
+
+  return nodes.back();
+}
+
+
+/** Sons of a node are pushed into a stack of nodes to be visited.
+ * Statements of a block are pushed as well, so that visits reach the
+ * whole tree.
+ * @param[in]  n           Index of the node
+ * @param[in,out] nodeStack Stack of nodes to be visited
+ */
+void AST::sons(Index n, vector<Index> &nodeStack) const
+{
+  const Node &node = nodes[n];
+  unsigned int i;
+
+  for(i = 0; i < 3 && node.sons[i] != None; ++i){
+    nodeStack.push_back(node.sons[i]);
+  }
+  if(node.type == Stm && node.opcode.statement == Blk){
+    const vector<Index> &sequence = sequences[node.value.block];
+    nodeStack.insert(nodeStack.end(), sequence.begin(), sequence.end());
+  }
+}
+
+
+/** Abstract syntax tree is restored from the content of a cache file.
+ * Nodes are decoded straight from the content, field by field. Every
+ * count and index is checked before it is used, every node shall be
+ * well formed, and links shall not form cycles, so that no visit of a
+ * corrupted tree can go astray.
+ * @param[in]  data        Content of the cache file
+ * @param[in]  size        Size of the content
+ * @retval     bool        True if the content is a valid cache
+ */
+bool AST::restore(const char *data, size_t size)
+{
+  vector<Index> offsets, statements, nodeStack, children;
+  vector<unsigned char> color;
+  const char *name, *end;
+  CacheHeader header;
+  size_t i, j;
+
+  // Header is checked against the size of the content.
+  if(size < headerSize){ return false; }
+  memcpy(header.magic, data, sizeof(header.magic));
+  data += sizeof(header.magic);
+  header.version    = get(data);
+  header.order      = get(data);
+  header.nodeSize   = get(data);
+  header.nodes      = get(data);
+  header.root       = get(data);
+  header.blocks     = get(data);
+  header.statements = get(data);
+  header.symbols    = get(data);
+  header.names      = get(data);
+  if(memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) != 0
+     || header.version != cacheVersion || header.order != cacheOrder
+     || header.nodeSize != recordSize
+     || size != headerSize + (size_t) header.nodes * recordSize
+                + ((size_t) header.blocks + 1) * sizeof(Index)
+                + (size_t) header.statements * sizeof(Index)
+                + header.names){
+    return false;
+  }
+
+  // Nodes are decoded, their fields being read into the matching member.
+  nodes.resize(header.nodes);
+  for(i = 0; i < nodes.size(); ++i){
+    Node &node = nodes[i];
+    uint32_t type = get(data), opcode = get(data), value = get(data);
+
+    if(type > BExp){ return false; }
+    node.type = (nodeType) type;
+    if(node.type == Stm){
+      if(opcode > In){ return false; }
+      node.opcode.statement = (StmType) opcode;
+      node.value.block      = value;
+    }
+    else if(node.type == AExp){
+      if(opcode > Pow){ return false; }
+      node.opcode.arithmetic = (AExpType) opcode;
+      if(opcode == Num){ node.value.num = (int) value; }
+      else{ node.value.var = value; }
+    }
+    else{
+      if(opcode > Neq || (opcode == Bool && value > 1)){ return false; }
+      node.opcode.boolean = (BExpType) opcode;
+      node.value.boolean  = (value == 1);
+    }
+    for(j = 0; j < 3; ++j){ node.sons[j] = get(data); }
+    node.negation = get(data);
+  }
+  offsets.resize(header.blocks + 1);
+  for(i = 0; i < offsets.size(); ++i){ offsets[i] = get(data); }
+  statements.resize(header.statements);
+  for(i = 0; i < statements.size(); ++i){ statements[i] = get(data); }
+
+  // Names are split at their terminators.
+  end = data + header.names;
+  for(name = data; name < end; name += symbols.back().size() + 1){
+    symbols.push_back(string(name, strnlen(name, end - name)));
+    if(name + symbols.back().size() == end){ return false; }
+    identifiers.emplace(symbols.back(), symbols.size() - 1);
+  }
+  if(symbols.size() != header.symbols){ return false; }
+
+  // Blocks are rebuilt, and hold statements only.
+  if(offsets[0] != 0 || offsets[header.blocks] != header.statements){
+    return false;
+  }
+  for(i = 0; i < statements.size(); ++i){
+    if(statements[i] >= nodes.size() || nodes[statements[i]].type != Stm){
+      return false;
+    }
+  }
+  for(i = 0; i < header.blocks; ++i){
+    if(offsets[i] > offsets[i + 1]){ return false; }
+  }
+  for(i = 0; i < header.blocks; ++i){
+    sequences.push_back(vector<Index>(statements.begin() + offsets[i],
+                                      statements.begin() + offsets[i + 1]));
+  }
+
+  // Root shall be a statement, and every node shall be well formed.
+  root = header.root;
+  if(nodes.empty() ? root != None
+                   : (root >= nodes.size() || nodes[root].type != Stm)){
+    return false;
+  }
+  for(i = 0; i < nodes.size(); ++i){
+    if(!wellFormed(i)){ return false; }
+  }
+
+  // Links shall not form cycles: nodes whose visit is in progress are
+  // marked, and reaching one of them again means a cycle.
+  color.assign(nodes.size(), 0);
+  for(i = 0; i < nodes.size(); ++i){
+    if(color[i] != 0){ continue; }
+    nodeStack.push_back(i);
+    while(!nodeStack.empty()){
+      Index n = nodeStack.back();
+
+      if(color[n] != 0){
+        color[n] = 2;
+        nodeStack.pop_back();
+        continue;
+      }
+      color[n] = 1;
+      children.clear();
+      sons(n, children);
+      for(j = 0; j < children.size(); ++j){
+        if(color[children[j]] == 1){ return false; }
+        if(color[children[j]] == 0){ nodeStack.push_back(children[j]); }
+      }
+    }
+  }
+
+  return true;
+}
+
+
+/** Node restored from a cache file is checked to be well formed.
+ * Node shall have exactly the sons its opcode requires, of the right
+ * types. Targets of assignments and inputs shall be variables, and
+ * slots and blocks shall exist. Boolean expressions, and only them,
+ * shall have a negation: the complementary expression over the same
+ * sons, whose negation is the node itself, or the son of a logical
+ * negation. Visits following negations thus never go deeper than the
+ * sons.
+ * @param[in]  n           Index of the node
+ * @retval     bool        True if the node is well formed
+ */
+bool AST::wellFormed(Index n) const
+{
+  static const BExpType complements[] = {
+    Bool, Not, Nand, Nor, Xnor, And, Or, Xor, Geq, Gt, Neq, Lt, Leq, Eq
+  };
+  const Node &node = nodes[n];
+  nodeType types[3] = {Stm, Stm, Stm};
+  unsigned int arity = 0, i;
+
+  // Arity and types of the sons are given by the opcode.
+  if(node.type == Stm){
+    switch(node.opcode.statement){
+      case Asn: arity = 2; types[0] = AExp; types[1] = AExp; break;
+      case If:  arity = 3; types[0] = BExp;                  break;
+      case Whl: arity = 2; types[0] = BExp;                  break;
+      case Prn:
+      case In:  arity = 1; types[0] = AExp;                  break;
+      default:  arity = 0;                                   break;
+    }
+  }
+  else if(node.type == AExp){
+    arity = (node.opcode.arithmetic <= Var) ? 0
+          : (node.opcode.arithmetic <= Opp) ? 1 : 2;
+    types[0] = types[1] = AExp;
+  }
+  else{
+    arity = (node.opcode.boolean == Bool) ? 0
+          : (node.opcode.boolean == Not)  ? 1 : 2;
+    types[0] = types[1] = (node.opcode.boolean >= Lt) ? AExp : BExp;
+  }
+  for(i = 0; i < 3; ++i){
+    if(i >= arity){
+      if(node.sons[i] != None){ return false; }
+    }
+    else if(node.sons[i] >= nodes.size()
+            || nodes[node.sons[i]].type != types[i]){
+      return false;
+    }
+  }
+
+  // Values refer to existing variables and blocks.
+  if(node.type == Stm
+     && (node.opcode.statement == Asn || node.opcode.statement == In)
+     && nodes[node.sons[0]].opcode.arithmetic != Var){
+    return false;
+  }
+  if(node.type == AExp && node.opcode.arithmetic == Var
+     && node.value.var >= symbols.size()){
+    return false;
+  }
+  if(node.type == Stm && node.opcode.statement == Blk
+     && node.value.block >= sequences.size()){
+    return false;
+  }
+
+  // Negations are consistent.
+  if(node.type != BExp){ return node.negation == None; }
+  if(node.negation >= nodes.size()){ return false; }
+  if(node.opcode.boolean == Not){ return node.negation == node.sons[0]; }
+
+  const Node &negation = nodes[node.negation];
+  if(negation.type != BExp || negation.negation != n
+     || negation.opcode.boolean != complements[node.opcode.boolean]){
+    return false;
+  }
+  if(node.opcode.boolean == Bool){
+    return negation.value.boolean != node.value.boolean;
+  }
+  for(i = 0; i < 3; ++i){
+    if(negation.sons[i] != node.sons[i]){ return false; }
+  }
+
+  return true;
+}
+
+
+/** Liveness of a statement is computed backwards.
+ * Variables dying at the statement, and at the guards inside it, are
+ * recorded along the way. Liveness of a loop is iterated until its
+ * head does not change any more.
+ * @param[in]  n           Index of the statement
+ * @param[in,out] live     Variables live after the statement, replaced
+ *                         by the ones live before it
+ */
+void AST::liveness(Index n, vector<bool> &live)
+{
+  const Node &node = nodes[n];
+  vector<bool> after, first, second;
+  unsigned int var, i;
+  bool changed;
+
+  if(node.type != Stm){ return; }
+
+  switch(node.opcode.statement){
+    case Asn:
+    case In:
+      after = live;
+      var   = nodes[node.sons[0]].value.var;
+      live[var] = false;
+      if(node.opcode.statement == Asn){ uses(node.sons[1], live); }
+      first = live;
+      first[var] = true;
+      kill(n, first, after);
+      return;
+
+    case Prn:
+      after = live;
+      uses(node.sons[0], live);
+      kill(n, live, after);
+      return;
+
+    case Skp:
+      return;
+
+    // Statements of a block are visited backwards.
+    case Blk:
+      for(i = sequences[node.value.block].size(); i > 0; --i){
+        liveness(sequences[node.value.block][i - 1], live);
+      }
+      return;
+
+    case If:
+      first  = live;
+      second = live;
+      liveness(node.sons[1], first);
+      liveness(node.sons[2], second);
+      for(i = 0; i < live.size(); ++i){ live[i] = first[i] || second[i]; }
+      uses(node.sons[0], live);
+      kill(node.sons[0], live, first);
+      kill(nodes[node.sons[0]].negation, live, second);
+      return;
+
+    case Whl:
+      after = live;
+      uses(node.sons[0], live);
+      do{
+        first = live;
+        liveness(node.sons[1], first);
+        changed = false;
+        for(i = 0; i < live.size(); ++i){
+          if(first[i] && !live[i]){ live[i] = changed = true; }
+        }
+      }
+      while(changed);
+      kill(node.sons[0], live, first);
+      kill(nodes[node.sons[0]].negation, live, after);
+      return;
+
+    default:
+      cerr << "[AST::liveness]: Unrecognized statement opcode value: "
+           << node.opcode.statement << "." << endl;
+      return;
+  }
+}
+
+
+/** Variables read by an expression are marked as live.
+ * @param[in]  n           Index of the expression
+ * @param[in,out] live     Set of live variables
+ */
+void AST::uses(Index n, vector<bool> &live) const
+{
+  const Node &node = nodes[n];
+  unsigned int i;
+
+  if(node.type == AExp && node.opcode.arithmetic == Var){
+    live[node.value.var] = true;
+    return;
+  }
+  for(i = 0; i < 3 && node.sons[i] != None; ++i){
+    uses(node.sons[i], live);
+  }
+}
+
+
+/** Variables in the first set and not in the second one are recorded
+ * as dying at the given node.
+ * @param[in]  n           Index of a statement or of a guard
+ * @param[in]  before      Variables live before the node
+ * @param[in]  after       Variables live after the node
+ */
+void AST::kill(Index n, const vector<bool> &before, const vector<bool> &after)
+{
+  unsigned int i;
+
+  dead[n].clear();
+  for(i = 0; i < before.size(); ++i){
+    if(before[i] && !after[i]){ dead[n].push_back(i); }
+  }
+}
+
+
+/** Subtree is optimized.
+ * Sons are optimized before their parents. Sons of a boolean
+ * expression are also updated in its negation, which shares them.
+ * @param[in]  n           Index of the subtree to be optimized
+ * @retval     Index       Index of the optimized subtree
+ */
+AST::Index AST::optimize(Index n)
+{
+  Index first, second, third, other;
+  vector<Index> statements;
+  long result;
+  bool num1, num2, constant;
+  size_t i;
+  int a1, a2;
+
+  if(n == None){ return n; }
+
+  first  = optimize(nodes[n].sons[0]);
+  second = optimize(nodes[n].sons[1]);
+  third  = optimize(nodes[n].sons[2]);
+
+  switch(nodes[n].type){
+    case Stm: switch(nodes[n].opcode.statement){
+      // Blocks drop the statements which were pruned, and absorb the
+      // blocks left by pruned branches.
+      case Blk:
+        statements.swap(sequences[nodes[n].value.block]);
+        for(i = 0; i < statements.size(); ++i){
+          first = optimize(statements[i]);
+          if(nodes[first].opcode.statement != Skp){ push(n, first); }
+        }
+        switch(sequences[nodes[n].value.block].size()){
+          case 0:  return node(Skp);
+          case 1:  return sequences[nodes[n].value.block][0];
+          default: return n;
+        }
+
+      // Branches decided by the guard are pruned.
+      case If:
+        if(nodes[first].opcode.boolean == Bool){
+          return nodes[first].value.boolean ? second : third;
+        }
+        break;
+
+      case Whl:
+        if(nodes[first].opcode.boolean == Bool
+           && !nodes[first].value.boolean){
+          return node(Skp);
+        }
+        break;
+
+      default:
+        break;
+    }
+    break;
+
+    case AExp:
+      num1 = first  != None && nodes[first].opcode.arithmetic  == Num;
+      num2 = second != None && nodes[second].opcode.arithmetic == Num;
+      a1   = num1 ? nodes[first].value.num  : 0;
+      a2   = num2 ? nodes[second].value.num : 0;
+
+      switch(nodes[n].opcode.arithmetic){
+        case Num:
+        case Var:
+          return n;
+
+        case Id:
+          return first;
+
+        case Opp:
+          if(num1 && compute(Sub, 0, a1, result)){
+            return node(Num, (int) result);
+          }
+          break;
+
+        default:
+          if(num1 && num2
+             && compute(nodes[n].opcode.arithmetic, a1, a2, result)){
+            return node(Num, (int) result);
+          }
+          break;
+      }
+
+      // Algebraic identities are simplified.
+      switch(nodes[n].opcode.arithmetic){
+        case Sum:
+          if(num1 && a1 == 0){ return second; }
+          if(num2 && a2 == 0){ return first; }
+          break;
+        case Sub:
+          if(num2 && a2 == 0){ return first; }
+          break;
+        case Mul:
+          if(num1 && a1 == 1){ return second; }
+          if(num2 && a2 == 1){ return first; }
+          break;
+        case Div:
+        case Pow:
+          if(num2 && a2 == 1){ return first; }
+          break;
+        default:
+          break;
+      }
+      break;
+
+    case BExp: switch(nodes[n].opcode.boolean){
+      case Bool:
+        return n;
+
+      // Negations are already precomputed, double ones cancel out.
+      case Not:
+        return nodes[first].negation;
+
+      case Lt:
+      case Leq:
+      case Eq:
+      case Geq:
+      case Gt:
+      case Neq:
+        if(nodes[first].opcode.arithmetic  != Num
+           || nodes[second].opcode.arithmetic != Num){
+          break;
+        }
+        a1 = nodes[first].value.num;
+        a2 = nodes[second].value.num;
+        switch(nodes[n].opcode.boolean){
+          case Lt:  return node(Bool, a1 <  a2);
+          case Leq: return node(Bool, a1 <= a2);
+          case Eq:  return node(Bool, a1 == a2);
+          case Geq: return node(Bool, a1 >= a2);
+          case Gt:  return node(Bool, a1 >  a2);
+          default:  return node(Bool, a1 != a2);
+        }
+
+      // When an operand is constant, the expression is either constant
+      // or the other operand, possibly negated.
+      default:
+        if(nodes[first].opcode.boolean == Bool){
+          constant = nodes[first].value.boolean;
+          other    = second;
+        }
+        else if(nodes[second].opcode.boolean == Bool){
+          constant = nodes[second].value.boolean;
+          other    = first;
+        }
+        else{
+          break;
+        }
+        switch(nodes[n].opcode.boolean){
+          case And:  return constant ? other : node(Bool, false);
+          case Or:   return constant ? node(Bool, true) : other;
+          case Xor:  return constant ? nodes[other].negation : other;
+          case Nand: return constant ? nodes[other].negation
+                                     : node(Bool, true);
+          case Nor:  return constant ? node(Bool, false)
+                                     : nodes[other].negation;
+          default:   return constant ? other : nodes[other].negation;
+        }
+    }
+    nodes[nodes[n].negation].sons[0] = first;
+    nodes[nodes[n].negation].sons[1] = second;
+    break;
+  }
+
+  nodes[n].sons[0] = first;
+  nodes[n].sons[1] = second;
+  nodes[n].sons[2] = third;
+
+  return n;
+}
+
+
+/** Arithmetic operation is computed on constants.
+ * Operation is not computed if it would fail or overflow at run time,
+ * so that it is left to the program.
+ * @param[in]  type        Type of the arithmetic expression
+ * @param[in]  a1          First operand
+ * @param[in]  a2          Second operand
+ * @param[out] result      Result of the operation
+ * @retval     bool        True if and only if the result was computed
+ */
+bool AST::compute(AExpType type, long a1, long a2, long &result)
+{
+  long i;
+
+  switch(type){
+    case Sum: result = a1 + a2; break;
+    case Sub: result = a1 - a2; break;
+    case Mul: result = a1 * a2; break;
+    case Div:
+      if(a2 == 0){ return false; }
+      result = a1 / a2;
+      break;
+    case Rem:
+      if(a2 == 0){ return false; }
+      result = a1 % a2;
+      break;
+    case Pow:
+      // Powers of 0, 1 and -1 are computed without iterating.
+      if(a2 <= 0){ result = 1; }
+      else if(a1 == 0 || a1 == 1){ result = a1; }
+      else if(a1 == -1){ result = (a2 % 2 == 0) ? 1 : -1; }
+      else{
+        result = 1;
+        for(i = 0; i < a2 && result >= INT_MIN && result <= INT_MAX; ++i){
+          result *= a1;
+        }
+      }
+      break;
+    default:
+      return false;
+  }
+
+  return result >= INT_MIN && result <= INT_MAX;
+}
+
+
+/** Negation of a boolean expression is precomputed.
+ * Boolean expression associated to the given node is reversed into a
+ * new node, which shares the sons of the given one, and the two nodes
+ * are linked to each other. For instance, if given node contains a
+ * 'less than' comparison between arithmetic expressions a1 and a2, a
+ * new node is appended, representing a 'greater than or equal to'
+ * comparison between a1 and a2. Negation of a logical negation is its
+ * own operand, so no node is appended. Sons are built before their
+ * parents, hence their negations are already available.
+ * @param[in]  n           Index of the boolean expression to be negated
+ * @retval     Index       Index of the given boolean expression
+ */
+AST::Index AST::negate(Index n)
+{
+  Node negation = nodes[n];
+
+  // New opcode is detected.
+  switch(negation.opcode.boolean){
+    case Bool:
+      negation.value.boolean = !negation.value.boolean;
+      break;
+    case Not:
+      nodes[n].negation = negation.sons[0];
+      return n;
+    case Lt:   negation.opcode.boolean = Geq;  break;
+    case Leq:  negation.opcode.boolean = Gt;   break;
+    case Eq:   negation.opcode.boolean = Neq;  break;
+    case Geq:  negation.opcode.boolean = Lt;   break;
+    case Gt:   negation.opcode.boolean = Leq;  break;
+    case Neq:  negation.opcode.boolean = Eq;   break;
+    case And:  negation.opcode.boolean = Nand; break;
+    case Or:   negation.opcode.boolean = Nor;  break;
+    case Xor:  negation.opcode.boolean = Xnor; break;
+    case Nand: negation.opcode.boolean = And;  break;
+    case Nor:  negation.opcode.boolean = Or;   break;
+    case Xnor: negation.opcode.boolean = Xor;  break;
+    default:
+      cerr << "[AST::negate]: Unrecognized boolean opcode value: "
+           << negation.opcode.boolean << "." << endl;
+      negation.opcode.boolean = Bool;
+      negation.value.boolean  = false;
+  }
+
+  negation.negation = n;
+  nodes.push_back(negation);
+  nodes[n].negation = nodes.size() - 1;
+
+  return n;
 }
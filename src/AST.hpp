@@ -8,15 +8,27 @@
 #ifndef AST_HPP
 #define AST_HPP
 
+#include <stdint.h>
+#include <limits>
 #include <vector>
 #include <string>
+#include <map>
 
 #include "AbstractState.hpp"
 
 using namespace std;
 
+class Zone;
+class Octagon;
+template <> class AbstractState<Zone>;
+template <> class AbstractState<Octagon>;
 
-/** Class representing an abstract syntax tree. */
+
+/** Class representing an abstract syntax tree.
+ * Nodes are stored into a contiguous arena and refer to their sons by
+ * 32 bit indices, so that traversals are cache friendly and the whole
+ * tree is freed at once.
+ */
 class AST
 {
   public:
@@ -24,7 +36,7 @@ class AST
   typedef enum{
     Asn,           ///< 'Assignment' statement
     Skp,           ///< 'Skip' statement
-    Seq,           ///< 'Sequential composition' statement
+    Blk,           ///< 'Block' of statements, executed in sequence
     If,            ///< 'If-then-else' branch statement
     Whl,           ///< 'While' loop statement
     Prn,           ///< 'Print' statement
@@ -66,93 +78,115 @@ class AST
   } BExpType;
   
   
-  /** Constructor of a 0-ary statement abstract syntax node.
-   * 0-ary statements are: skip (Skp).
-   * @param[in]  type        Type of the statement
-   */
-  AST(StmType type);
+  /** Type representing the iteration strategy of loops. */
+  typedef struct{
+    unsigned int delay;      ///< Iterations joined before widening
+    unsigned int narrowing;  ///< Descending iterations after the fixpoint
+    unsigned int budget;     ///< Iterations after which unstable values
+                             ///<  become top, 0 for no limit
+  } Strategy;
+  
+  
+  /** Type representing the index of a node in the arena. */
+  typedef uint32_t Index;
+  
   
+  static const Index None = 0xFFFFFFFF; ///< Index of a missing node
   
-  /** Constructor of a unary statement abstract syntax node.
-   * Unary statements are: print (Prn), input (In).
-   * @param[in]  type        Type of the stament
-   * @param[in]  first       Subtree representing the argument
+  
+  /** Constructor of an empty abstract syntax tree.
+   * Nodes are added through the node() methods, and the root is set
+   * through setRoot().
    */
-  AST(StmType type, AST *first);
+  AST();
   
   
-  /** Constructor of a binary statement abstract syntax node.
-   * Binary statements are: assignment (Asn), sequential composition
-   * (Seq), while loop (Whl).
-   * @param[in]  type        Type of the statement
-   * @param[in]  first       Subtree representing the first argument
-   * @param[in]  second      Subtree representing the second argument
+  /** Destructor of an abstract syntax tree.
+   * Every node lives in the same arena, which is freed in one shot.
    */
-  AST(StmType type, AST *first, AST *second);
+  ~AST();
   
   
-  /** Constructor of a ternary statement abstract syntax node.
+  /** Constructor of a statement abstract syntax node.
+   * 0-ary statements are: skip (Skp).
+   * Unary statements are: print (Prn), input (In), block (Blk), whose
+   * argument is its first statement, if any.
+   * Binary statements are: assignment (Asn), while loop (Whl).
    * Ternary statements are: if-then-else branch (If).
    * @param[in]  type        Type of the statement
    * @param[in]  first       Subtree representing the first argument
    * @param[in]  second      Subtree representing the second argument
    * @param[in]  third       Subtree representing the third argument
+   * @retval     Index       Index of the new node
    */
-  AST(StmType type, AST *first, AST *second, AST *third);
+  Index node(StmType type, Index first = None, Index second = None,
+             Index third = None);
+  
+  
+  /** A statement is appended to a block.
+   * Statements of a nested block are appended one by one instead, so
+   * that blocks stay flat.
+   * @param[in]  block       Index of the block
+   * @param[in]  statement   Index of the statement
+   */
+  void push(Index block, Index statement);
   
   
   /** Constructor of a numeric constant abstract syntax node.
    * Numeric constant expressions are: num (Num).
    * @param[in]  type        Type of the arithmetic expression
    * @param[in]  num         Constant, integer value
+   * @retval     Index       Index of the new node
    */
-  AST(AExpType type, int num);
+  Index node(AExpType type, int num);
   
   
   /** Constructor of a variable synatax node.
-   * Varibales are: var (Var).
+   * Varibales are: var (Var). Identifiers are interned, so that every
+   * node refers to an entry of the symbol table instead of holding a
+   * copy of the name.
    * @param[in]  type        Type of the arithmetic expression
    * @param[in]  var         Name of the variable
+   * @retval     Index       Index of the new node
    */
-  AST(AExpType type, string var);
+  Index node(AExpType type, const char *var);
   
   
-  /** Constructor of an unary arithmetic expression abstract syntax node.
-   * Unary arithmetic expressions are: identity (Id), opposite (Opp).
+  /** Constructor of a variable synatax node from a lexeme.
+   * Name needs not to be terminated, so that the parser can refer to
+   * the source code instead of copying it.
    * @param[in]  type        Type of the arithmetic expression
-   * @param[in]  a           Operand
+   * @param[in]  var         Name of the variable
+   * @param[in]  length      Length of the name
+   * @retval     Index       Index of the new node
    */
-  AST(AExpType type, AST *a);
+  Index node(AExpType type, const char *var, size_t length);
   
   
-  /** Constructor of a binary arithmetic expression abstract syntax node.
+  /** Constructor of an arithmetic expression abstract syntax node.
+   * Unary arithmetic expressions are: identity (Id), opposite (Opp).
    * Binary arithmetic expressions are: sum (Sum), subtraction (Sub),
    * multiplication (Mul), integer division (Div), remainder of the
    * integer division (Rem), raise to the power (Pow).
    * @param[in]  type        Type of the arithmetic expression
    * @param[in]  a1          First operand
-   * @param[in]  a2          Second operand
+   * @param[in]  a2          Second operand, if any
+   * @retval     Index       Index of the new node
    */
-  AST(AExpType type, AST *a1, AST *a2);
+  Index node(AExpType type, Index a1, Index a2 = None);
   
   
   /** Constructor of a constant, boolean value.
    * Constant, boolean values are: boolean (Bool).
    * @param[in]  type        Type of the boolean value
    * @param[in]  boolean     Boolean value
+   * @retval     Index       Index of the new node
    */
-  AST(BExpType type, bool boolean);
+  Index node(BExpType type, bool boolean);
   
   
-  /** Constructor of a unary boolean expression abstract syntax node.
+  /** Constructor of a boolean expression abstract syntax node.
    * Unary boolean expressions are: logical negation (Not).
-   * @param[in]  type        Type of the boolean expression
-   * @param[in]  b           Operand
-   */
-  AST(BExpType type, AST *b);
-  
-  
-  /** Constructor of a binary boolean expression abstract syntax node.
    * Binary boolean expressions are: logical conjunction (And), logical
    * disjunction (Or), logical exclusive disjunction (Xor), negated
    * conjunction (Nand), negated disjunction (Nor), negated exclusive
@@ -161,235 +195,308 @@ class AST
    * to' comparison, 'greater than' comparison, 'not equal to' comparison.
    * @param[in]  type        Type of the boolean expression
    * @param[in]  b1          First operand
-   * @param[in]  b2          Second operand
+   * @param[in]  b2          Second operand, if any
+   * @retval     Index       Index of the new node
    */
-  AST(BExpType type, AST *b1, AST *b2);
+  Index node(BExpType type, Index b1, Index b2 = None);
   
   
-  /** Destructor of an abstract syntax tree. */
-  ~AST();
+  /** Root of the abstract syntax tree is set.
+   * @param[in]  root        Index of the root node
+   */
+  void setRoot(Index root);
+  
+  
+  /** Number of nodes in the arena is returned.
+   * @retval     size_t      Number of nodes
+   */
+  size_t size() const;
+  
+  
+  /** Symbol resolution pass.
+   * Every distinct identifier is assigned a dense slot, so that
+   * variables can be accessed by index instead of by name. Slots follow
+   * the alphabetical order of names.
+   */
+  void resolve();
+  
+  
+  /** Optimization pass.
+   * Constant subexpressions are folded, algebraic identities are
+   * simplified and branches decided by a constant guard are pruned, so
+   * that every engine evaluates a smaller tree. Nodes which are no
+   * longer reachable are left in the arena.
+   */
+  void optimize();
+  
   
+  /** Liveness analysis.
+   * Variables which die at each statement, at each guard and at the
+   * end of each loop are computed backwards, so that interpret() drops
+   * their bindings and states only hold live variables. Only the given
+   * variables are live at the end of the program, the others are not
+   * kept for the final state.
+   * @param[in]  observed    Name of the variables live at the end
+   */
+  void liveness(const vector<string> &observed);
+  
+  
+  /** Symbol table built by the resolution pass is returned.
+   * @retval     vector<string> * Name of the variable in each slot
+   */
+  const vector<string> *variables() const;
+  
+  
+  /** Constants of the program are returned.
+   * Every constant is returned together with its neighbours, so that
+   * both strict and non strict comparisons can be used as widening
+   * thresholds.
+   * @retval     vector<long> Constants, in no particular order
+   */
+  vector<long> constants() const;
   
-  /** A textual representation of the node is provided.
+  
+  /** Variables of the program are partitioned into packs.
+   * Variables which may be related by an assignment, a comparison or a
+   * sum of two variables are in the same pack, so that relational
+   * domains can keep a separate, smaller, state for each pack.
+   * @retval     vector<unsigned int> Pack of the variable in each slot,
+   *                         packs being numbered from 0
+   */
+  vector<unsigned int> packs() const;
+  
+  
+  /** Iteration strategy of loops is set.
+   * By default loops are widened from the first iteration, are not
+   * narrowed and have no limit on iterations.
+   * @param[in]  strategy    Iteration strategy
+   */
+  void setStrategy(const Strategy &strategy);
+  
+  
+  /** A textual representation of a node is provided.
+   * @param[in]  n           Index of the node
    * @retval     string      String representing the node
    */
-  string toString();
+  string toString(Index n) const;
   
   
   /** Abstract syntax tree is exported to graphviz.
-   * The abstract syntax tree rooted in the current node is esported
-   * into a file which can later be compiled using graphviz.
+   * The abstract syntax tree is esported into a file which can later be
+   * compiled using graphviz.
    * @param[in]  filename    Path to the output file
    */
-  void toGraphviz(const char *filename);
+  void toGraphviz(const char *filename) const;
+  
+  
+  /** Abstract syntax tree is saved into a binary cache file.
+   * Only the nodes reachable from the root are written, renumbered
+   * densely, so that the tree can be analyzed again without scanning,
+   * parsing, resolving and optimizing the source code. The file holds,
+   * in native byte order and with no padding: a header (magic, version,
+   * byte order mark, size of a node record and the counts below), the
+   * nodes as words (type, opcode, value, three sons and negation), the
+   * offset of the statements of each block, the statements of every
+   * block and the names of the variables, terminated by '\0', in slot
+   * order.
+   * @param[in]  filename    Path to the output file
+   * @retval     bool        True if the file was written
+   */
+  bool save(const char *filename) const;
   
   
-  /** Abstract syntax tree is interpreted from the bottom state.
+  /** Abstract syntax tree is loaded from a binary cache file.
+   * File is mapped in memory and checked, so that a stale or corrupted
+   * cache is rejected instead of being analyzed. Tree is already
+   * resolved and optimized.
+   * @param[in]  filename    Path to the cache file, written by save()
+   * @retval     AST *       Abstract syntax tree, owned by the caller,
+   *                         NULL if the file could not be loaded
+   */
+  static AST *load(const char *filename);
+  
+  
+  /** Abstract syntax tree is interpreted from the initial state.
    * Type of (abstract) interpretation is parametric.
    * @retval     AbstractState Final state
    */
   template <typename D>
-  AbstractState<D> interpret()
+  AbstractState<D> interpret() const
   {
-    return interpret(AbstractState<D>());
+    AbstractState<D> state(&symbols);
+    
+    interpret(root, state);
+    return state;
   }
   
   
   /** Abstract syntax tree is interpreted in the given state.
-   * Type of (abstract) interpretation is parametric.
-   * @param[in]  state       Initial state
-   * @retval     AbstractState Final state
+   * Type of (abstract) interpretation is parametric. State is updated
+   * in place, so that it is only copied where control flow branches.
+   * Statements are not visited at all in the bottom state, so that
+   * unreachable branches and loop bodies cost nothing. Variables which
+   * are found dead by liveness() are dropped along the way.
+   * @param[in]  n           Index of the statement to be interpreted
+   * @param[in,out] state    Initial state, replaced by the final one
    */
   template <typename D>
-  AbstractState<D> interpret(AbstractState<D> state)
+  void interpret(Index n, AbstractState<D> &state) const
   {
-    AbstractState<D> s;
+    const Node &node = nodes[n];
+    Index guard = node.sons[0], negation;
+    AbstractState<D> s, entry;
+    unsigned int iterations = 0;
+    size_t i;
     
-    // If node is not a statement, just return the current state.
-    if(type != Stm){ return state; }
+    // If node is not a statement or it is not reachable, just keep the
+    // current state.
+    if(node.type != Stm || state.isBottom()){ return; }
     
     // Correct action is taken depending on the statement type.
-    switch(opcode.statement){
+    switch(node.opcode.statement){
       case Asn:
-        state.store(*(sons[0]->value.var), sons[1]->A(state));
-        return state;
+      case In:
+        assign(n, state);
+        prune(n, state);
+        return;
       
       case Skp:
-        return state;
+        return;
       
-      case Seq:
-        return sons[1]->interpret(sons[0]->interpret(state));
+      // Statements of a block are iterated, not recursed into.
+      case Blk:
+        for(i = 0; i < sequences[node.value.block].size()
+                   && !state.isBottom(); ++i){
+          interpret(sequences[node.value.block][i], state);
+        }
+        return;
       
       case If:
-        return AbstractState<D>::lub(
-          sons[1]->interpret(sons[0]->B(state)),
-          sons[2]->interpret(sons[0]->neg().B(state))
-        );
+        negation = nodes[guard].negation;
+        s = state;
+        B(nodes[guard], state);
+        prune(guard, state);
+        interpret(node.sons[1], state);
+        B(nodes[negation], s);
+        prune(negation, s);
+        interpret(node.sons[2], s);
+        state.join(s);
+        return;
       
+      // Loop is widened after the delay, saturated after the budget, and
+      // narrowed once its fixpoint is reached.
       case Whl:
+        negation = nodes[guard].negation;
+        entry    = state;
         do{
-          s     = state;
-          state = sons[1]->interpret(sons[0]->B(state));
-          state = AbstractState<D>::lub(s, state);
-          state = AbstractState<D>::widening(s, state);
+          s = state;
+          B(nodes[guard], state);
+          prune(guard, state);
+          interpret(node.sons[1], state);
+          state.join(s);
+          ++iterations;
+          if(iterations > strategy.delay){ state.widen(s); }
+          if(strategy.budget && iterations > strategy.budget){
+            state.saturate(s);
+          }
         }
         while(s != state);
-        state = sons[0]->neg().B(state);
-        return state;
+        for(iterations = 0; iterations < strategy.narrowing; ++iterations){
+          s = state;
+          B(nodes[guard], state);
+          prune(guard, state);
+          interpret(node.sons[1], state);
+          state.join(entry);
+          if(s == state){ break; }
+        }
+        B(nodes[negation], state);
+        prune(negation, state);
+        return;
       
       case Prn:
-        return state;
-      
-      case In:
-        state.store(*(sons[0]->value.var), D::top());
-        return state;
+        prune(n, state);
+        return;
       
       default:
         cerr << "[AST::Interpret]: Unrecognized statement opcode value: "
-             << opcode.statement << "." << endl;
-        return state;
+             << node.opcode.statement << "." << endl;
+        return;
     }
   }
   
   
   /** An arithmetic expression is evaluated in the given state.
    * Abstract evaluation is parametric.
+   * @param[in]  n           Index of the expression to be evaluated
    * @param[in]  state       Initial state
    * @retval     T           Resulting abstract value
    */
   template <typename T>
-  T A(AbstractState<T> state)
+  T A(Index n, const AbstractState<T> &state) const
   {
+    const Node &node = nodes[n];
+    
     // If node is not an arithmetic expression, just return an empty value.
-    if(type != AExp){ return T(); }
+    if(node.type != AExp){ return T(); }
     
     // Correct action is taken depending on the type of operation.
-    switch(opcode.arithmetic){
-      case Num: return T::alpha(value.num);
-      case Var: return state.load(*(value.var));
-      case Id:  return +(sons[0]->A(state));
-      case Opp: return -(sons[0]->A(state));
-      case Sum: return sons[0]->A(state) + sons[1]->A(state);
-      case Sub: return sons[0]->A(state) - sons[1]->A(state);
-      case Mul: return sons[0]->A(state) * sons[1]->A(state);
-      case Div: return sons[0]->A(state) / sons[1]->A(state);
-      case Rem: return sons[0]->A(state) % sons[1]->A(state);
-      case Pow: return sons[0]->A(state) ^ sons[1]->A(state);
+    switch(node.opcode.arithmetic){
+      case Num: return T::alpha(node.value.num);
+      case Var: return state.load(node.value.var);
+      case Id:  return +(A(node.sons[0], state));
+      case Opp: return -(A(node.sons[0], state));
+      case Sum: return A(node.sons[0], state) + A(node.sons[1], state);
+      case Sub: return A(node.sons[0], state) - A(node.sons[1], state);
+      case Mul: return A(node.sons[0], state) * A(node.sons[1], state);
+      case Div: return A(node.sons[0], state) / A(node.sons[1], state);
+      case Rem: return A(node.sons[0], state) % A(node.sons[1], state);
+      case Pow: return A(node.sons[0], state) ^ A(node.sons[1], state);
       default:
         cerr << "[AST::A]: Unrecognized arithmetic opcode value: "
-             << opcode.arithmetic << "." << endl;
+             << node.opcode.arithmetic << "." << endl;
         return T();
     }
   }
   
   
-  /** Boolean expression is evaluated in the given state.
-   * Type of abstract evaluation is parametric.
-   * @param[in]  state       Initial state
-   * @retval     AbstractState The state itself if the evaluation was
-   *                         true, the bottom state otherwise
-   */
-  template <typename D>
-  AbstractState<D> B(AbstractState<D> state)
-  {
-    AbstractState<D> bottom, s;
-   
-    // If node is not a boolean expression, just return the current state.
-    if(type != BExp){ return state; }
-    
-    // Correct action is taken depending on the type of expression.
-    switch(opcode.boolean){
-      case Bool:
-        return (value.boolean) ? state : bottom;
-      
-      case Not:
-        return sons[0]->neg().B(state);
-      
-      case And:
-        return sons[1]->B(sons[0]->B(state));
-      
-      case Or:
-        return AbstractState<D>::lub(
-          sons[0]->B(state),
-          sons[1]->B(state)
-        );
-      
-      case Xor:
-        return AbstractState<D>::lub(
-          sons[0]->B(sons[1]->neg().B(state)),
-          sons[0]->neg().B(sons[1]->B(state))
-        );
-      
-      case Nand: case Nor:  case Xnor:
-        return (neg().B(state) == bottom)
-             ? state : bottom;
-      
-      case Lt:
-        return (sons[0]->A(state) < sons[1]->A(state))
-             ? state : bottom;
-      
-      case Leq:
-        return (sons[0]->A(state) <= sons[1]->A(state))
-             ? state : bottom;
-      
-      case Eq:
-        return (sons[0]->A(state) == sons[1]->A(state))
-             ? state : bottom;
-      
-      case Geq:
-        return (sons[0]->A(state) >= sons[1]->A(state))
-             ? state : bottom;
-      
-      case Gt:
-        return (sons[0]->A(state) > sons[1]->A(state))
-             ? state : bottom;
-      
-      case Neq:
-        return (sons[0]->A(state) != sons[1]->A(state))
-             ? state : bottom;
-      
-      default:
-        cerr << "[AST::B]: Unrecognized boolean opcode value: "
-             << opcode.boolean << "." << endl;
-        return state;
-    }
-  }
-  
-  
   /** Concrete excecution is performed starting from the bottom state.
    * @retval     AbstractState State containing the result of the
    *                         (concrete) compupation
    */
-  AbstractState<int> execute();
+  AbstractState<int> execute() const;
   
   
   /** Concrete excecution is performed starting from the given state.
-   * @param[in]  state       Initial state
-   * @retval     AbstractState State containing the result of the
-   *                         (concrete) compupation
+   * @param[in]  n           Index of the statement to be executed
+   * @param[in,out] state    Initial state, replaced by the final one
    */
-  AbstractState<int> execute(AbstractState<int> state);
+  void execute(Index n, AbstractState<int> &state) const;
   
   
   /** An arithmetic expression is evaluated in the given state.
    * Evaluation is performed on the concrete values.
+   * @param[in]  n           Index of the expression to be evaluated
    * @param[in]  state       Concrete state where expression is
    *                         evaluated
    * @retval     int         Evaluated arithmetic expression
    */
-  int A(AbstractState<int> state);
+  int A(Index n, const AbstractState<int> &state) const;
   
   
   /** Boolean expression is evaluated in the given state.
    * Evaluation is perfomed on the concrete values.
+   * @param[in]  n           Index of the expression to be evaluated
    * @param[in]  state       Initial state
    * @retval     bool        True if and only if the boolean expression
    *                         evaluates to true
    */
-  bool B(AbstractState<int>);
+  bool B(Index n, const AbstractState<int> &state) const;
   
   
   private:
+  friend class Bytecode;
+  friend class CFG;
+  
   /** Type of an abstract syntax node. */
   typedef enum{
     Stm,                ///< Statement node
@@ -400,7 +507,8 @@ class AST
   /** Type representing a value associated to the node. */
   typedef union{
     int  num;           ///< Constant, integer value
-    string *var;        ///< Name of a variable
+    unsigned int var;   ///< Slot of a variable
+    unsigned int block; ///< Statements of a block, in sequences
     bool boolean;       ///< Constant, boolean value
   } valueType;
   
@@ -411,25 +519,419 @@ class AST
     BExpType   boolean;      ///< Node is a boolean expression
   } opcodeType;
   
+  /** Type representing a node of the arena.
+   * Every node has a fixed arity of three sons, linked by index. Blocks
+   * have no sons: their statements are kept contiguous in sequences.
+   */
+  typedef struct{
+    nodeType   type;    ///< Type of the node
+    opcodeType opcode;  ///< Opcode of the node
+    valueType  value;   ///< Value associated to the node, if any
+    Index      sons[3]; ///< Indices of the sons, None if missing
+    Index      negation;///< Index of the negated boolean expression
+  } Node;
+  
+  
+  vector<Node>   nodes;   ///< Arena holding every node
+  vector< vector<Index> > sequences;     ///< Statements of each block
+  Index          root;    ///< Index of the root node
+  vector<string> symbols; ///< Name of the variable in each slot
+  map<string, unsigned int, less<> > identifiers;
+                          ///< Slot of each identifier, which can be
+                          ///<  looked up without building a string
+  vector< vector<unsigned int> > dead;   ///< Slots of the variables dying
+                                         ///<  at each node
+  Strategy       strategy;              ///< Iteration strategy of loops
+  
+  
+  /** A node is appended to the arena.
+   * @param[in]  type        Type of the node
+   * @param[in]  first       First son, if any
+   * @param[in]  second      Second son, if any
+   * @param[in]  third       Third son, if any
+   * @retval     Node &      Reference to the new node
+   */
+  Node &append(nodeType type, Index first = None, Index second = None,
+               Index third = None);
+  
+  
+  /** Sons of a node are pushed into a stack of nodes to be visited.
+   * Statements of a block are pushed as well, so that visits reach the
+   * whole tree.
+   * @param[in]  n           Index of the node
+   * @param[in,out] nodeStack Stack of nodes to be visited
+   */
+  void sons(Index n, vector<Index> &nodeStack) const;
+  
+  
+  /** Abstract syntax tree is restored from the content of a cache file.
+   * Nodes are decoded straight from the content, field by field. Every
+   * count and index is checked before it is used, every node shall be
+   * well formed, and links shall not form cycles, so that no visit of a
+   * corrupted tree can go astray.
+   * @param[in]  data        Content of the cache file
+   * @param[in]  size        Size of the content
+   * @retval     bool        True if the content is a valid cache
+   */
+  bool restore(const char *data, size_t size);
+  
+  
+  /** Node restored from a cache file is checked to be well formed.
+   * Node shall have exactly the sons its opcode requires, of the right
+   * types. Targets of assignments and inputs shall be variables, and
+   * slots and blocks shall exist. Boolean expressions, and only them,
+   * shall have a negation: the complementary expression over the same
+   * sons, whose negation is the node itself, or the son of a logical
+   * negation. Visits following negations thus never go deeper than the
+   * sons.
+   * @param[in]  n           Index of the node
+   * @retval     bool        True if the node is well formed
+   */
+  bool wellFormed(Index n) const;
+  
+  
+  /** Boolean expression is evaluated in the given state.
+   * Type of abstract evaluation is parametric. State is filtered in
+   * place: it is kept if the evaluation was true, it becomes the bottom
+   * state otherwise. Negations are precomputed by negate(), so that
+   * expressions are evaluated in negation normal form without building
+   * any node.
+   * @param[in]  node        Boolean expression to be evaluated
+   * @param[in,out] state    State to be filtered
+   */
+  template <typename D>
+  void B(const Node &node, AbstractState<D> &state) const
+  {
+    AbstractState<D> s;
+    bool holds;
+   
+    // If node is not a boolean expression or state is already bottom,
+    // just keep the current state.
+    if(node.type != BExp || state.isBottom()){ return; }
+    
+    // Correct action is taken depending on the type of expression.
+    switch(node.opcode.boolean){
+      case Bool:
+        holds = node.value.boolean;
+        break;
+      
+      case Not:
+        B(nodes[nodes[node.sons[0]].negation], state);
+        return;
+      
+      case And:
+        B(nodes[node.sons[0]], state);
+        B(nodes[node.sons[1]], state);
+        return;
+      
+      case Or:
+        s = state;
+        B(nodes[node.sons[0]], state);
+        B(nodes[node.sons[1]], s);
+        state.join(s);
+        return;
+      
+      case Xor:
+        s = state;
+        B(nodes[nodes[node.sons[1]].negation], state);
+        B(nodes[node.sons[0]], state);
+        B(nodes[node.sons[1]], s);
+        B(nodes[nodes[node.sons[0]].negation], s);
+        state.join(s);
+        return;
+      
+      // Negated operators are evaluated by De Morgan's laws.
+      case Nand:
+        s = state;
+        B(nodes[nodes[node.sons[0]].negation], state);
+        B(nodes[nodes[node.sons[1]].negation], s);
+        state.join(s);
+        return;
+      
+      case Nor:
+        B(nodes[nodes[node.sons[0]].negation], state);
+        B(nodes[nodes[node.sons[1]].negation], state);
+        return;
+      
+      case Xnor:
+        s = state;
+        B(nodes[node.sons[0]], state);
+        B(nodes[node.sons[1]], state);
+        B(nodes[nodes[node.sons[0]].negation], s);
+        B(nodes[nodes[node.sons[1]].negation], s);
+        state.join(s);
+        return;
+      
+      case Lt:
+      case Leq:
+      case Eq:
+      case Geq:
+      case Gt:
+      case Neq:
+        compare(node, state);
+        return;
+      
+      default:
+        cerr << "[AST::B]: Unrecognized boolean opcode value: "
+             << node.opcode.boolean << "." << endl;
+        return;
+    }
+    
+    if(!holds){ state.clear(); }
+  }
   
-  static unsigned int lastID;  ///< Last assigned nodeID
-  unsigned int nodeID;  ///< ID of the node
-  nodeType     type;    ///< Type of the node
-  AST *        parent;  ///< Pointer to parent node
-  vector<AST*> sons;    ///< List of sons
-  valueType    value;   ///< Value associated to the node, if any
-  opcodeType   opcode;  ///< Opcode of the node
+  
+  /** An assignment or an input statement is interpreted.
+   * Variable is bound to the value of the expression, or to top if it
+   * is read from the input.
+   * @param[in]  n           Index of the statement
+   * @param[in,out] state    State to be updated
+   */
+  template <typename D>
+  void assign(Index n, AbstractState<D> &state) const
+  {
+    const Node &node = nodes[n];
+    unsigned int var = nodes[node.sons[0]].value.var;
+    
+    if(node.opcode.statement == In){ state.store(var, D::top()); }
+    else{ state.store(var, A(node.sons[1], state)); }
+  }
   
   
-  /** Boolean expression is negated.
-   * Boolean expression associated to the current node is reversed and
-   * returned into a new sub-tree.
-   * For instance, if current node contains a 'less than' comparison
-   * between arithmetic expressions a1 and a2, a new sub-tree is created,
-   * whose root is a node representing a 'greater than or equal to'
-   * comparison between a1 and a2.
-   * @retval     AST         Negated boolean expression
+  /** An assignment or an input statement is interpreted over zones.
+   * @param[in]  n           Index of the statement
+   * @param[in,out] state    State to be updated
+   */
+  void assign(Index n, AbstractState<Zone> &state) const;
+
+
+  /** An assignment or an input statement is interpreted over octagons.
+   * @param[in]  n           Index of the statement
+   * @param[in,out] state    State to be updated
+   */
+  void assign(Index n, AbstractState<Octagon> &state) const;
+
+
+  /** An assignment or an input statement is interpreted over a
+   * relational domain. Assignments of a variable, or of its opposite,
+   * plus a constant keep the relation between the variables, if the
+   * state can represent it; any other expression is evaluated over
+   * intervals.
+   * @param[in]  n           Index of the statement
+   * @param[in,out] state    State to be updated
+   */
+  template <typename S>
+  void assignRelational(Index n, S &state) const;
+  
+  
+  /** Comparison is evaluated in the given state.
+   * State becomes the bottom state if the comparison does not hold,
+   * it is refined by refine() otherwise.
+   * @param[in]  node        Comparison to be evaluated
+   * @param[in,out] state    State to be filtered
+   */
+  template <typename D>
+  void compare(const Node &node, AbstractState<D> &state) const
+  {
+    D a = A(node.sons[0], state), b = A(node.sons[1], state);
+    bool holds;
+    
+    switch(node.opcode.boolean){
+      case Lt:  holds = a <  b; break;
+      case Leq: holds = a <= b; break;
+      case Eq:  holds = a == b; break;
+      case Geq: holds = a >= b; break;
+      case Gt:  holds = a >  b; break;
+      default:  holds = a != b; break;
+    }
+    
+    if(!holds){ state.clear(); }
+    else{ refine(node, state); }
+  }
+  
+  
+  /** Comparison is evaluated over zones.
+   * @param[in]  node        Comparison to be evaluated
+   * @param[in,out] state    State to be filtered
+   */
+  void compare(const Node &node, AbstractState<Zone> &state) const;
+  
+  
+  /** Comparison is evaluated over octagons.
+   * @param[in]  node        Comparison to be evaluated
+   * @param[in,out] state    State to be filtered
+   */
+  void compare(const Node &node, AbstractState<Octagon> &state) const;
+  
+  
+  /** Comparison is evaluated over a relational domain.
+   * Comparisons between variables plus constants are added to the state
+   * as constraints, if the state can represent them; any other side is
+   * evaluated over intervals.
+   * @param[in]  node        Comparison to be evaluated
+   * @param[in,out] state    State to be filtered
+   */
+  template <typename S>
+  void compareRelational(const Node &node, S &state) const;
+  
+  
+  /** Predicate testing whether an expression is a variable, or its
+   * opposite, plus a constant, such as y, -y, y + c, c - y or -(y - c).
+   * @param[in]  n           Index of the expression
+   * @param[out] var         Slot of the variable
+   * @param[out] sign        Sign of the variable, 1 or -1
+   * @param[out] c           Constant added to the variable
+   * @retval     bool        True if expression has one of such forms
+   */
+  bool linear(Index n, unsigned int &var, int &sign, long &c) const;
+  
+  
+  /** An arithmetic expression is evaluated over intervals in a state
+   * over a relational domain.
+   * Missing bounds are represented by the limits of long.
+   * @param[in]  n           Index of the expression
+   * @param[in]  state       State over a relational domain
+   * @param[out] lower       Lower bound of the expression
+   * @param[out] upper       Upper bound of the expression
+   */
+  template <typename S>
+  void evaluate(Index n, const S &state, long &lower, long &upper) const;
+  
+  
+  /** Constraint l <= r + d is added to a state over a relational
+   * domain.
+   * @param[in]  l           Index of the left expression
+   * @param[in]  r           Index of the right expression
+   * @param[in]  d           Constant added to the right expression
+   * @param[in,out] state    State to be filtered
+   */
+  template <typename S>
+  void lessEqual(Index l, Index r, long d, S &state) const;
+  
+  
+  /** State is refined by a comparison which holds in it.
+   * Only comparisons between a variable and a constant are considered:
+   * the value of the variable is met with the range allowed by the
+   * comparison. Without this, loop guards would never bound a counter,
+   * and neither thresholds nor narrowing could recover its bounds.
+   * @param[in]  node        Comparison which holds in the state
+   * @param[in,out] state    State to be refined
+   */
+  template <typename D>
+  void refine(const Node &node, AbstractState<D> &state) const
+  {
+    const long min = numeric_limits<long>::min();
+    const long max = numeric_limits<long>::max();
+    const Node *var = &nodes[node.sons[0]], *num = &nodes[node.sons[1]];
+    BExpType opcode = node.opcode.boolean;
+    long c;
+    D value;
+    
+    // Constant on the left is moved to the right, mirroring the operator.
+    if(var->opcode.arithmetic == Num){
+      swap(var, num);
+      switch(opcode){
+        case Lt:  opcode = Gt;  break;
+        case Leq: opcode = Geq; break;
+        case Geq: opcode = Leq; break;
+        case Gt:  opcode = Lt;  break;
+        default:  break;
+      }
+    }
+    if(var->opcode.arithmetic != Var || num->opcode.arithmetic != Num){
+      return;
+    }
+    
+    c     = num->value.num;
+    value = state.load(var->value.var);
+    switch(opcode){
+      case Lt:  value.meet(min, c - 1); break;
+      case Leq: value.meet(min, c);     break;
+      case Eq:  value.meet(c, c);       break;
+      case Geq: value.meet(c, max);     break;
+      case Gt:  value.meet(c + 1, max); break;
+      default:  return;
+    }
+    
+    state.store(var->value.var, value);
+  }
+  
+  
+  /** Variables which die at the given node are dropped from the state.
+   * @param[in]  n           Index of a statement or of a guard
+   * @param[in,out] state    State to be pruned
+   */
+  template <typename D>
+  void prune(Index n, AbstractState<D> &state) const
+  {
+    unsigned int i;
+    
+    if(n >= dead.size()){ return; }
+    for(i = 0; i < dead[n].size(); ++i){
+      state.erase(dead[n][i]);
+    }
+  }
+  
+  
+  /** Liveness of a statement is computed backwards.
+   * Variables dying at the statement, and at the guards inside it, are
+   * recorded along the way.
+   * @param[in]  n           Index of the statement
+   * @param[in,out] live     Variables live after the statement, replaced
+   *                         by the ones live before it
+   */
+  void liveness(Index n, vector<bool> &live);
+  
+  
+  /** Variables read by an expression are marked as live.
+   * @param[in]  n           Index of the expression
+   * @param[in,out] live     Set of live variables
+   */
+  void uses(Index n, vector<bool> &live) const;
+  
+  
+  /** Variables in the first set and not in the second one are recorded
+   * as dying at the given node.
+   * @param[in]  n           Index of a statement or of a guard
+   * @param[in]  before      Variables live before the node
+   * @param[in]  after       Variables live after the node
+   */
+  void kill(Index n, const vector<bool> &before, const vector<bool> &after);
+  
+  
+  /** Subtree is optimized.
+   * Sons are optimized before their parents. Sons of a boolean
+   * expression are also updated in its negation, which shares them.
+   * @param[in]  n           Index of the subtree to be optimized
+   * @retval     Index       Index of the optimized subtree
+   */
+  Index optimize(Index n);
+  
+  
+  /** Arithmetic operation is computed on constants.
+   * Operation is not computed if it would fail or overflow at run
+   * time, so that it is left to the program.
+   * @param[in]  type        Type of the arithmetic expression
+   * @param[in]  a1          First operand
+   * @param[in]  a2          Second operand
+   * @param[out] result      Result of the operation
+   * @retval     bool        True if and only if the result was computed
+   */
+  static bool compute(AExpType type, long a1, long a2, long &result);
+  
+  
+  /** Negation of a boolean expression is precomputed.
+   * Boolean expression associated to the given node is reversed into a
+   * new node, which shares the sons of the given one, and the two nodes
+   * are linked to each other. For instance, if given node contains a
+   * 'less than' comparison between arithmetic expressions a1 and a2, a
+   * new node is appended, representing a 'greater than or equal to'
+   * comparison between a1 and a2. Negation of a logical negation is its
+   * own operand, so no node is appended. Sons are built before their
+   * parents, hence their negations are already available.
+   * @param[in]  n           Index of the boolean expression to be negated
+   * @retval     Index       Index of the given boolean expression
    */
-  AST neg();
+  Index negate(Index n);
 };
 #endif
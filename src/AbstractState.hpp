@@ -9,45 +9,132 @@
 #define ABSTRACT_STATE_HPP
 
 #include <iostream>
+#include <memory>
 #include <string>
-#include <map>
+#include <type_traits>
+#include <vector>
 
 using namespace std;
 
 
-/** Template representing an abstract state. */
+/** Template representing an abstract state.
+ * Variables are identified by the dense slot assigned to them by the
+ * symbol resolution pass. Bindings are kept into a persistent radix
+ * trie indexed by slot, whose nodes are shared among states and never
+ * modified once built: copying a state is constant time, an update only
+ * copies the path to the updated slot, and binary operations skip the
+ * subtrees which are physically shared by the operands. A fingerprint
+ * of the bindings is updated along with every change, so that states
+ * which differ are told apart in constant time. Names of the variables
+ * are only needed to dump the state. Bottom state, reached by control
+ * flow which is not feasible, is marked explicitly: it is absorbing for
+ * updates and neutral for least upperbounds, so that dead code is never
+ * analyzed. Variables which were never assigned are 0, as in the
+ * concrete interpreter, see AbstractState::initial().
+ */
 template <typename T>
 class AbstractState
 {
   public:
+  /** Constructor of the bottom state.
+   * Bottom state has no names attached, they are taken from the first
+   * state joined with it.
+   */
+  AbstractState()
+  {
+    names  = NULL;
+    depth  = 0;
+    bottom = true;
+  }
+  
+  
+  /** Constructor of a state with no bindings.
+   * @param[in]  names       Name of the variable in each slot
+   */
+  AbstractState(const vector<string> *names)
+  {
+    this->names = names;
+    depth       = 0;
+    bottom      = false;
+    while(capacity(depth) < names->size()){ ++depth; }
+  }
+  
+  
+  /** Copy constructor.
+   * Trie is shared, so copying takes constant time. Copies are
+   * counted, see AbstractState::copies.
+   * @param[in]  other       State to be copied
+   */
+  AbstractState(const AbstractState<T> &other)
+    : names(other.names), root(other.root), depth(other.depth),
+      bottom(other.bottom)
+  {
+    ++copies;
+  }
+  
+  
+  /** Move constructor.
+   * Bindings are stolen from the given state, no copy is performed.
+   * @param[in]  other       State to be moved
+   */
+  AbstractState(AbstractState<T> &&other) noexcept = default;
+  
+  
+  /** Copy assignment operator overloading.
+   * Trie is shared, so copying takes constant time. Copies are
+   * counted, see AbstractState::copies.
+   * @param[in]  other       State to be copied
+   * @retval     AbstractState Reference to the current state
+   */
+  AbstractState<T> &operator=(const AbstractState<T> &other)
+  {
+    names  = other.names;
+    root   = other.root;
+    depth  = other.depth;
+    bottom = other.bottom;
+    ++copies;
+    return *this;
+  }
+  
+  
+  /** Move assignment operator overloading.
+   * @param[in]  other       State to be moved
+   * @retval     AbstractState Reference to the current state
+   */
+  AbstractState<T> &operator=(AbstractState<T> &&other) noexcept = default;
+  
+  
   /** 'Less than or equal to' operator overloading.
    * @param[in]  other       Abstract state to be compared
    * @retval     bool        True if and only if every variable in the
    *                         first state is defined with the same
    *                         value also in the second state
    */
-  bool operator<=(AbstractState<T> other)
+  bool operator<=(const AbstractState<T> &other) const
   {
-    bool included = true;
-    typename map<string, T>::iterator it;
-    
-    it = state.begin();
-    while(included && it != state.end()){
-      included = T::equal(it->second, other.state[it->first]);
-      ++it;
-    }
+    unsigned int level = (depth > other.depth) ? depth : other.depth;
     
-    return included;
+    if(bottom || other.bottom){ return bottom; }
+    return included(lift(root, depth, level),
+                    lift(other.root, other.depth, level), level);
   }
   
   
   /** 'Equal to' operator overloading.
+   * States sharing the same trie are equal, states with different
+   * fingerprints are not: bindings are only compared when neither test
+   * decides. Such comparisons are counted, see
+   * AbstractState::comparisons.
    * @param[in]  other       Abstract state to be compared
    * @retval     bool        True if and only if states map the same
    *                         variable name to the same value
    */
-  bool operator==(AbstractState<T> other)
+  bool operator==(const AbstractState<T> &other) const
   {
+    if(bottom || other.bottom){ return bottom == other.bottom; }
+    if(root == other.root){ return true; }
+    if(fingerprint() != other.fingerprint()){ return false; }
+    ++comparisons;
     return *this <= other && other <= *this;
   }
   
@@ -56,45 +143,170 @@ class AbstractState
    * @param[in]  other       Abstract state to be compared
    * @retval     bool        True if and only if states are not equal
    */
-  bool operator!=(AbstractState<T> other)
+  bool operator!=(const AbstractState<T> &other) const
   {
     return !(*this == other);
   }
   
   
   /** A lookup operation is performed on the state.
-   * @param[in]  var         Name of the variable to be returned
+   * Variables which are not bound evaluate to the initial value.
+   * @param[in]  var         Slot of the variable to be returned
    * @retval     T           Abstract value associated to the variable
    */
-  T load(string var)
+  T load(unsigned int var) const
   {
-    return state[var];
+    const Node *node = root.get();
+    unsigned int level = depth;
+    
+    if(var >= capacity(depth)){ return initial(); }
+    while(node != NULL && level > 0){
+      node = node->sons[slot(var, level)].get();
+      --level;
+    }
+    
+    return (node != NULL && node->bound & (1U << slot(var, 0)))
+         ? node->values[slot(var, 0)] : initial();
   }
   
   
   /** Abstract value of the given variable is updated.
-   * If variable was not in state, it is added.
-   * @param[in]  var         Name of the variable to be updated
+   * If variable was not in state, it is added. Only the path leading to
+   * the variable is copied, the rest of the trie is shared. Bottom
+   * state is left unchanged.
+   * @param[in]  var         Slot of the variable to be updated
    * @param[in]  value       New abstract value of the variable
    */
-  void store(string var, T value)
+  void store(unsigned int var, const T &value)
+  {
+    if(bottom){ return; }
+    while(var >= capacity(depth)){
+      root = lift(root, depth, depth + 1);
+      ++depth;
+    }
+    root = assign(root.get(), var, value, depth);
+  }
+  
+  
+  /** Binding of the given variable is removed.
+   * Variable evaluates to the initial value again. Only the path
+   * leading to the variable is copied, and only if it was bound.
+   * @param[in]  var         Slot of the variable to be removed
+   */
+  void erase(unsigned int var)
   {
-    state[var] = value;
+    if(bottom || var >= capacity(depth)){ return; }
+    root = remove(root, var, depth);
+  }
+  
+  
+  /** Every binding is removed.
+   * State becomes the bottom state, without any copy.
+   */
+  void clear()
+  {
+    root.reset();
+    bottom = true;
+  }
+  
+  
+  /** Predicate testing whether the state is the bottom state.
+   * @retval     bool        True if and only if control flow reaching
+   *                         the state is not feasible
+   */
+  bool isBottom() const
+  {
+    return bottom;
   }
   
   
   /** A textual representation of the state is provided.
-   * State is dumped to standart output.
+   * State is dumped to the given stream, standard output by default.
+   * Slots are assigned in alphabetical order, so variables are listed
+   * by name.
+   * @param[out] out         Output stream
    */
-  void dump()
+  void dump(ostream &out = cout) const
   {
-    typename map<string, T>::iterator it;
+    if(bottom){
+      out << "bot" << endl;
+      return;
+    }
+    out << "[";
+    dump(out, root.get(), depth, 0);
+    out << "]" << endl;
+  }
+  
+  
+  /** Least upperbound with the given state is computed in place.
+   * Common entries with same values and different entries are kept
+   * directly. Conflicting entries are resolved with a least upperbound
+   * computation. Subtrees shared by the states are not visited. Bottom
+   * state is neutral.
+   * @param[in]  other       State to be joined with the current one
+   */
+  void join(const AbstractState<T> &other)
+  {
+    unsigned int level = (depth > other.depth) ? depth : other.depth;
     
-    cout << "[";
-    for(it = state.begin(); it != state.end(); ++it){
-      cout << it->first << " -> " << it->second << ", ";
+    if(other.bottom){ return; }
+    if(bottom){
+      *this = other;
+      return;
     }
-    cout << "]" << endl;
+    root  = merge(lift(root, depth, level),
+                  lift(other.root, other.depth, level), level, 0);
+    depth = level;
+  }
+  
+  
+  /** Widening is applied in place to every element of the state.
+   * Current state is the one reached by the last iteration. Subtrees
+   * shared by the states are not visited, since widening a value with
+   * itself gives the value back. Nothing is widened if either state is
+   * the bottom state.
+   * @param[in]  previous    State reached by the previous iteration
+   */
+  void widen(const AbstractState<T> &previous)
+  {
+    unsigned int level = (depth > previous.depth) ? depth : previous.depth;
+    
+    if(bottom || previous.bottom){ return; }
+    root  = combine(lift(root, depth, level),
+                    lift(previous.root, previous.depth, level), level, 0,
+                    [](const T &p, const T &c){ return T::nabla(p, c); });
+    depth = level;
+  }
+  
+  
+  /** Every value which changed since the previous state is set to top.
+   * This is used to stop the iterations on a loop whose budget has been
+   * exhausted: unstable values give up any information, so that the
+   * fixpoint is reached in a number of steps bounded by the number of
+   * variables.
+   * @param[in]  previous    State reached by the previous iteration
+   */
+  void saturate(const AbstractState<T> &previous)
+  {
+    unsigned int level = (depth > previous.depth) ? depth : previous.depth;
+    
+    if(bottom || previous.bottom){ return; }
+    root  = combine(lift(root, depth, level),
+                    lift(previous.root, previous.depth, level), level, 0,
+                    [](const T &p, T c){
+                      return T::equal(p, c) ? c : T::top();
+                    });
+    depth = level;
+  }
+  
+  
+  /** Fingerprint of the state is returned.
+   * States which are equal have the same fingerprint.
+   * @retval     size_t      Hash of the bindings
+   */
+  size_t fingerprint() const
+  {
+    return root ? root->hash : 0;
   }
   
   
@@ -104,25 +316,12 @@ class AbstractState
    * @param[in]  s2          Second state to be compared
    * @retval     AbstractState<T> Least upperbound between states
    */
-  static AbstractState<T> lub(AbstractState<T> s1, AbstractState<T> s2)
+  static AbstractState<T> lub(const AbstractState<T> &s1,
+                              const AbstractState<T> &s2)
   {
-    AbstractState<T> lub;
-    typename map<string, T>::iterator it;
-    string var;
+    AbstractState<T> lub(s1);
     
-    // Common entries with same values and different entries are copied
-    // directly. Conflicting entries are resolved with a least
-    // upperbound computation.
-    lub.state = s1.state;
-    for(it = s2.state.begin(); it != s2.state.end(); ++it){
-      var = it->first;
-      if(lub.state.find(var) == lub.state.end()){
-        lub.state[var] = it->second; 
-      }
-      else{
-        lub.state[var] =  T::lub(s1.state[var], it->second);
-      }
-    }
+    lub.join(s2);
     return lub;
   }
   
@@ -133,20 +332,378 @@ class AbstractState
    * @param[in]  s2          Current state
    * @retval     AbstractState State where every element has been widened
    */
-  static AbstractState<T> widening(AbstractState<T> s1, AbstractState<T> s2)
+  static AbstractState<T> widening(const AbstractState<T> &s1,
+                                   const AbstractState<T> &s2)
   {
-    AbstractState<T> widened;
-    typename map<string, T>::iterator it;
-    
-    for(it = s2.state.begin(); it != s2.state.end(); ++it){
-      widened.state[it->first] = T::nabla(s1.state[it->first], it->second);
-    }
+    AbstractState<T> widened(s2);
     
+    widened.widen(s1);
     return widened;
   }
   
   
+  /** Value of a variable which was never assigned.
+   * Variables start from 0 in every domain, as in the concrete
+   * interpreter, so that unbound variables mean the same everywhere.
+   * @retval     T           Abstraction of 0
+   */
+  static T initial()
+  {
+    if constexpr (is_same<T, int>::value){ return 0; }
+    else{ return T::alpha(0); }
+  }
+  
+  
+  static unsigned long copies;      ///< Number of state copies performed
+  static unsigned long comparisons; ///< Number of full comparisons
+  
+  
   private:
-  map<string, T> state; ///< Set of bindings variable - abstract value
+  static const unsigned int Bits  = 4;          ///< Bits of slot per level
+  static const unsigned int Width = 1U << Bits; ///< Sons of each node
+  
+  /** Type representing a node of the trie.
+   * Leaves hold values, inner nodes hold sons. Nodes are never modified
+   * once they are reachable from a state.
+   */
+  struct Node{
+    shared_ptr<const Node> sons[Width]; ///< Sons, for inner nodes
+    T             values[Width];        ///< Values, for leaves
+    unsigned int  bound;                ///< Mask of bound slots, for leaves
+    size_t        hash;                 ///< Sum of the contributions of
+                                        ///<  the bindings in the subtrie
+    
+    /** Constructor of an empty node. */
+    Node() : values(), bound(0), hash(0) {}
+  };
+  
+  /** Type representing a reference to a shared node. */
+  typedef shared_ptr<const Node> Ref;
+  
+  
+  const vector<string> *names; ///< Name of the variable in each slot
+  Ref          root;            ///< Root of the trie, NULL if empty
+  unsigned int depth;           ///< Number of inner levels of the trie
+  bool         bottom;          ///< True for the bottom state
+  
+  
+  /** Hash of a concrete value.
+   * @param[in]  value       Concrete value
+   * @retval     size_t      Hash of the value
+   */
+  static size_t digest(int value)
+  {
+    return (size_t) value;
+  }
+  
+  
+  /** Hash of an abstract value.
+   * @param[in]  value       Abstract value
+   * @retval     size_t      Hash of the value
+   */
+  template <typename U>
+  static size_t digest(const U &value)
+  {
+    return U::hash(value);
+  }
+  
+  
+  /** Contribution of a binding to the fingerprint.
+   * Fingerprint is the sum of the contributions of every binding.
+   * Binding a variable to the initial value contributes nothing, just
+   * like leaving it unbound, since the two states are equal.
+   * @param[in]  var         Slot of the variable
+   * @param[in]  value       Value of the variable
+   * @retval     size_t      Contribution to the fingerprint
+   */
+  static size_t contribution(unsigned int var, const T &value)
+  {
+    return (digest(value) ^ digest(initial()))
+         * ((((size_t) var << 1) | 1) * (size_t) 0x9E3779B97F4A7C15ULL);
+  }
+  
+  
+  /** Hash of a node is computed from its bindings or its sons.
+   * @param[in,out] node     Node to be hashed
+   * @param[in]  level       Level of the node
+   * @param[in]  base        Slot of the first variable in the node
+   */
+  static void rehash(Node &node, unsigned int level, unsigned int base)
+  {
+    unsigned int i;
+    
+    node.hash = 0;
+    for(i = 0; i < Width; ++i){
+      if(level > 0){
+        if(node.sons[i]){ node.hash += node.sons[i]->hash; }
+      }
+      else if(node.bound & (1U << i)){
+        node.hash += contribution(base + i, node.values[i]);
+      }
+    }
+  }
+  
+  
+  /** Number of slots addressed by a trie of the given depth.
+   * @param[in]  depth       Number of inner levels
+   * @retval     unsigned long Number of slots
+   */
+  static unsigned long capacity(unsigned int depth)
+  {
+    return 1UL << (Bits * (depth + 1));
+  }
+  
+  
+  /** Position of a slot in a node of the given level.
+   * @param[in]  var         Slot of the variable
+   * @param[in]  level       Level of the node, 0 for leaves
+   * @retval     unsigned int Index of the son or of the value
+   */
+  static unsigned int slot(unsigned int var, unsigned int level)
+  {
+    return (var >> (Bits * level)) & (Width - 1);
+  }
+  
+  
+  /** A trie is deepened up to the given depth.
+   * Slots are unchanged, since the old root becomes the first son.
+   * @param[in]  node        Root of the trie
+   * @param[in]  from        Current depth of the trie
+   * @param[in]  to          Requested depth of the trie
+   * @retval     Ref         Root of the deepened trie
+   */
+  static Ref lift(Ref node, unsigned int from, unsigned int to)
+  {
+    shared_ptr<Node> parent;
+    
+    if(!node){ return node; }
+    for(; from < to; ++from){
+      parent = make_shared<Node>();
+      parent->sons[0] = node;
+      parent->hash    = node->hash;
+      node = parent;
+    }
+    
+    return node;
+  }
+  
+  
+  /** A value is assigned to a slot, by copying the path to it.
+   * @param[in]  node        Root of the subtrie, NULL if empty
+   * @param[in]  var         Slot of the variable
+   * @param[in]  value       Value to be assigned
+   * @param[in]  level       Level of the root of the subtrie
+   * @retval     Ref         Root of the updated subtrie
+   */
+  static Ref assign(const Node *node, unsigned int var, const T &value,
+                    unsigned int level)
+  {
+    shared_ptr<Node> copy = node ? make_shared<Node>(*node)
+                                 : make_shared<Node>();
+    unsigned int i = slot(var, level);
+    
+    if(level == 0){
+      copy->values[i] = value;
+      copy->bound    |= 1U << i;
+    }
+    else{
+      copy->sons[i] = assign(node ? node->sons[i].get() : NULL, var, value,
+                             level - 1);
+    }
+    rehash(*copy, level, var & ~((1UL << (Bits * (level + 1))) - 1));
+    
+    return copy;
+  }
+  
+  
+  /** A slot is unbound, by copying the path to it.
+   * @param[in]  node        Root of the subtrie, NULL if empty
+   * @param[in]  var         Slot of the variable
+   * @param[in]  level       Level of the root of the subtrie
+   * @retval     Ref         Root of the updated subtrie
+   */
+  static Ref remove(const Ref &node, unsigned int var, unsigned int level)
+  {
+    shared_ptr<Node> copy;
+    Ref son;
+    unsigned int i = slot(var, level);
+    
+    if(!node){ return node; }
+    
+    if(level == 0){
+      if(!(node->bound & (1U << i))){ return node; }
+      copy = make_shared<Node>(*node);
+      copy->values[i] = initial();
+      copy->bound    &= ~(1U << i);
+    }
+    else{
+      son = remove(node->sons[i], var, level - 1);
+      if(son == node->sons[i]){ return node; }
+      copy = make_shared<Node>(*node);
+      copy->sons[i] = son;
+    }
+    rehash(*copy, level, var & ~((1UL << (Bits * (level + 1))) - 1));
+    
+    return copy;
+  }
+  
+  
+  /** Inclusion test between subtries.
+   * @param[in]  a           First subtrie
+   * @param[in]  b           Second subtrie
+   * @param[in]  level       Level of the subtries
+   * @retval     bool        True if every binding of a is also in b
+   */
+  static bool included(const Ref &a, const Ref &b, unsigned int level)
+  {
+    unsigned int i;
+    
+    if(!a || a == b){ return true; }
+    
+    for(i = 0; i < Width; ++i){
+      if(level > 0){
+        if(!included(a->sons[i], b ? b->sons[i] : Ref(), level - 1)){
+          return false;
+        }
+      }
+      else if(a->bound & (1U << i)){
+        if(!T::equal(a->values[i],
+                     (b && (b->bound & (1U << i))) ? b->values[i]
+                                                   : initial())){
+          return false;
+        }
+      }
+    }
+    
+    return true;
+  }
+  
+  
+  /** Least upperbound between subtries.
+   * Nodes of a are reused wherever nothing changes. Variables bound in a
+   * subtrie only are joined with the initial value.
+   * @param[in]  a           First subtrie
+   * @param[in]  b           Second subtrie
+   * @param[in]  level       Level of the subtries
+   * @param[in]  base        Slot of the first variable in the subtries
+   * @retval     Ref         Least upperbound of the subtries
+   */
+  static Ref merge(const Ref &a, const Ref &b, unsigned int level,
+                   unsigned int base)
+  {
+    shared_ptr<Node> copy;
+    Ref son;
+    T value;
+    unsigned int i;
+    bool inA, inB;
+    
+    if(a == b){ return a; }
+    
+    for(i = 0; i < Width; ++i){
+      if(level > 0){
+        son = merge(a ? a->sons[i] : Ref(), b ? b->sons[i] : Ref(),
+                    level - 1, base + (i << (Bits * level)));
+        if(son == (a ? a->sons[i] : Ref())){ continue; }
+        if(!copy){ copy = a ? make_shared<Node>(*a) : make_shared<Node>(); }
+        copy->sons[i] = son;
+        continue;
+      }
+      
+      inA = a && (a->bound & (1U << i));
+      inB = b && (b->bound & (1U << i));
+      if(!inA && !inB){ continue; }
+      value = T::lub(inA ? a->values[i] : initial(),
+                     inB ? b->values[i] : initial());
+      if(inA && T::equal(value, a->values[i])){ continue; }
+      if(!copy){ copy = a ? make_shared<Node>(*a) : make_shared<Node>(); }
+      copy->values[i] = value;
+      copy->bound    |= 1U << i;
+    }
+    
+    if(!copy){ return a; }
+    rehash(*copy, level, base);
+    return copy;
+  }
+  
+  
+  /** Values of the current subtrie are combined with the previous ones.
+   * Nodes of the current subtrie are reused wherever nothing changes.
+   * Operation must give the current value back when both values are
+   * the same, so that shared subtrees are not visited.
+   * @param[in]  current     Subtrie reached by the last iteration
+   * @param[in]  previous    Subtrie reached by the previous iteration
+   * @param[in]  level       Level of the subtries
+   * @param[in]  base        Slot of the first variable in the subtries
+   * @param[in]  operation   Operation on the previous and current value
+   * @retval     Ref         Combined subtrie
+   */
+  template <typename F>
+  static Ref combine(const Ref &current, const Ref &previous,
+                     unsigned int level, unsigned int base, F operation)
+  {
+    shared_ptr<Node> copy;
+    Ref son;
+    T value;
+    unsigned int i;
+    
+    if(!current || current == previous){ return current; }
+    
+    for(i = 0; i < Width; ++i){
+      if(level > 0){
+        son = combine(current->sons[i],
+                      previous ? previous->sons[i] : Ref(), level - 1,
+                      base + (i << (Bits * level)), operation);
+        if(son == current->sons[i]){ continue; }
+        if(!copy){ copy = make_shared<Node>(*current); }
+        copy->sons[i] = son;
+      }
+      else if(current->bound & (1U << i)){
+        value = operation((previous && (previous->bound & (1U << i)))
+                          ? previous->values[i] : initial(),
+                          current->values[i]);
+        if(T::equal(value, current->values[i])){ continue; }
+        if(!copy){ copy = make_shared<Node>(*current); }
+        copy->values[i] = value;
+      }
+    }
+    
+    if(!copy){ return current; }
+    rehash(*copy, level, base);
+    return copy;
+  }
+  
+  
+  /** A textual representation of a subtrie is provided.
+   * @param[out] out         Output stream
+   * @param[in]  node        Subtrie to be dumped
+   * @param[in]  level       Level of the subtrie
+   * @param[in]  base        Slot of the first variable in the subtrie
+   */
+  void dump(ostream &out, const Node *node, unsigned int level,
+            unsigned int base) const
+  {
+    unsigned int i;
+    T value;
+    
+    if(node == NULL){ return; }
+    
+    for(i = 0; i < Width; ++i){
+      if(level > 0){
+        dump(out, node->sons[i].get(), level - 1,
+             base + (i << (Bits * level)));
+      }
+      else if(node->bound & (1U << i)){
+        value = node->values[i];
+        out << (*names)[base + i] << " -> " << value << ", ";
+      }
+    }
+  }
 };
+
+template <typename T>
+unsigned long AbstractState<T>::copies = 0;
+
+
+template <typename T>
+unsigned long AbstractState<T>::comparisons = 0;
 #endif
@@ -0,0 +1,448 @@
+/** Bytecode compiler and virtual machine.
+ * Class handling the compilation of an abstract syntax tree into a
+ * compact, linear bytecode, and its concrete execution on a register
+ * based virtual machine.
+ *
+ * @file Bytecode.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#include <iostream>
+
+#include "Bytecode.hpp"
+
+
+/** Constructor of a compiled program.
+ * The given abstract syntax tree is compiled into bytecode.
+ * @param[in]  program     Abstract syntax tree of the program, whose
+ *                         symbols have already been resolved
+ */
+Bytecode::Bytecode(const AST *program)
+{
+  size_t i;
+
+  // Variables are bound to the lowest registers, temporaries follow.
+  tree        = program;
+  variables   = *(program->variables());
+  temporaries = 0;
+  registers   = 0;
+  assigned.assign(variables.size(), false);
+  nesting     = 0;
+  compileStm(program->root);
+  emit(Hlt);
+
+  // Temporaries have been given negative numbers while compiling, since
+  // the number of variables was unknown: they are moved past variables.
+  for(i = 0; i < code.size(); ++i){
+    Instruction &in = code[i];
+    switch(in.op){
+      case Ldi: case In: case Prn:
+        if(in.a < 0){ in.a = (int) variables.size() - in.a - 1; }
+        break;
+      case Jmp:
+        break;
+      case Jz: case Jnz:
+        if(in.b < 0){ in.b = (int) variables.size() - in.b - 1; }
+        break;
+      case Jlt: case Jleq: case Jeq: case Jgeq: case Jgt: case Jneq:
+        if(in.b < 0){ in.b = (int) variables.size() - in.b - 1; }
+        if(in.c < 0){ in.c = (int) variables.size() - in.c - 1; }
+        break;
+      default:
+        if(in.a < 0){ in.a = (int) variables.size() - in.a - 1; }
+        if(in.b < 0){ in.b = (int) variables.size() - in.b - 1; }
+        if(in.c < 0){ in.c = (int) variables.size() - in.c - 1; }
+    }
+  }
+  registers += (int) variables.size();
+}
+
+
+/** Compiled program is executed starting from the zero state.
+ * Every variable is initialized to zero, but only the assigned ones
+ * are stored in the final state, as the tree walking interpreter does.
+ * @retval     AbstractState State containing the result of the
+ *                         (concrete) computation
+ */
+AbstractState<int> Bytecode::run()
+{
+  AbstractState<int> state(&variables);
+  vector<int> file(registers + 1, 0);
+  vector<bool> defined(assigned);
+  int *r = &file[0];
+  const Instruction *program = &code[0];
+  const Instruction *pc = program;
+  int i, pow;
+  size_t v;
+
+  // Fetch-decode-execute loop.
+  for(;;){
+    const Instruction &in = *pc++;
+    switch(in.op){
+      case Ldi: r[in.a] = in.b;                     break;
+      case Mov: r[in.a] = r[in.b];                  break;
+      case Opp: r[in.a] = -r[in.b];                 break;
+      case Sum: r[in.a] = r[in.b] +  r[in.c];       break;
+      case Sub: r[in.a] = r[in.b] -  r[in.c];       break;
+      case Mul: r[in.a] = r[in.b] *  r[in.c];       break;
+      case Div: r[in.a] = r[in.b] /  r[in.c];       break;
+      case Rem: r[in.a] = r[in.b] %  r[in.c];       break;
+      case Pow:
+        pow = 1;
+        for(i = 0; i < r[in.c]; ++i){ pow *= r[in.b]; }
+        r[in.a] = pow;
+        break;
+      case Not: r[in.a] = !r[in.b];                 break;
+      case And: r[in.a] = r[in.b] & r[in.c];        break;
+      case Or:  r[in.a] = r[in.b] | r[in.c];        break;
+      case Xor: r[in.a] = r[in.b] ^ r[in.c];        break;
+      case Lt:  r[in.a] = r[in.b] <  r[in.c];       break;
+      case Leq: r[in.a] = r[in.b] <= r[in.c];       break;
+      case Eq:  r[in.a] = r[in.b] == r[in.c];       break;
+      case Geq: r[in.a] = r[in.b] >= r[in.c];       break;
+      case Gt:  r[in.a] = r[in.b] >  r[in.c];       break;
+      case Neq: r[in.a] = r[in.b] != r[in.c];       break;
+      case Jmp:                                     pc = program + in.a; break;
+      case Jz:   if(!r[in.b])             { pc = program + in.a; } break;
+      case Jnz:  if( r[in.b])             { pc = program + in.a; } break;
+      case Jlt:  if(r[in.b] <  r[in.c])   { pc = program + in.a; } break;
+      case Jleq: if(r[in.b] <= r[in.c])   { pc = program + in.a; } break;
+      case Jeq:  if(r[in.b] == r[in.c])   { pc = program + in.a; } break;
+      case Jgeq: if(r[in.b] >= r[in.c])   { pc = program + in.a; } break;
+      case Jgt:  if(r[in.b] >  r[in.c])   { pc = program + in.a; } break;
+      case Jneq: if(r[in.b] != r[in.c])   { pc = program + in.a; } break;
+      case Prn:  cout << r[in.a] << endl;           break;
+      case In:
+        cout << "> " << variables[in.a] << " := ";
+        cin >> r[in.a];
+        break;
+      case Def:  defined[in.a] = true;              break;
+      case Hlt:
+        for(v = 0; v < variables.size(); ++v){
+          if(defined[v]){ state.store(v, r[v]); }
+        }
+        return state;
+      default:
+        cerr << "[Bytecode::run]: Unrecognized operation: "
+             << in.op << "." << endl;
+        return state;
+    }
+  }
+}
+
+
+/** Number of instructions of the compiled program is returned.
+ * @retval     size_t      Number of instructions
+ */
+size_t Bytecode::size()
+{
+  return code.size();
+}
+
+
+/** An instruction is appended to the program.
+ * @param[in]  op          Operation
+ * @param[in]  a           First operand
+ * @param[in]  b           Second operand
+ * @param[in]  c           Third operand
+ * @retval     size_t      Address of the instruction
+ */
+size_t Bytecode::emit(OpType op, int a, int b, int c)
+{
+  Instruction in;
+
+  in.op = op;  in.a = a;  in.b = b;  in.c = c;
+  code.push_back(in);
+
+  return code.size() - 1;
+}
+
+
+/** Jumps in the given list are set to target the next instruction.
+ * @param[in]  jumps       Addresses of the jumps to be patched
+ */
+void Bytecode::patch(vector<size_t> &jumps)
+{
+  vector<size_t>::iterator it;
+
+  for(it = jumps.begin(); it != jumps.end(); ++it){
+    code[*it].a = (int) code.size();
+  }
+  jumps.clear();
+}
+
+
+/** A new temporary register is allocated.
+ * Temporaries are numbered with negative integers until the end of the
+ * compilation, when the number of variables is known.
+ * @retval     int         Index of the temporary register
+ */
+int Bytecode::temporary()
+{
+  ++temporaries;
+  if(temporaries > registers){ registers = temporaries; }
+
+  return -temporaries;
+}
+
+
+/** A variable is recorded as assigned by the statement being compiled.
+ * Statements outside of conditionals and loops are surely executed if
+ * the program halts, so their variables are known to be assigned;
+ * elsewhere, a Def instruction marks the variable at run time, unless
+ * it has already been surely assigned.
+ * @param[in]  var         Slot of the assigned variable
+ */
+void Bytecode::define(int var)
+{
+  if(0 == nesting){ assigned[var] = true; }
+  else if(!assigned[var]){ emit(Def, var); }
+}
+
+
+/** A statement is compiled.
+ * @param[in]  n           Statement to be compiled
+ */
+void Bytecode::compileStm(AST::Index n)
+{
+  const AST::Node &node = tree->nodes[n];
+  vector<size_t> jumps, exit;
+  size_t body, i;
+
+  // Temporaries do not survive a statement.
+  temporaries = 0;
+
+  switch(node.opcode.statement){
+    case AST::Asn:
+      compileAExp(node.sons[1], tree->nodes[node.sons[0]].value.var);
+      define(tree->nodes[node.sons[0]].value.var);
+      break;
+
+    case AST::Skp:
+      break;
+
+    case AST::Blk:
+      for(i = 0; i < tree->sequences[node.value.block].size(); ++i){
+        compileStm(tree->sequences[node.value.block][i]);
+      }
+      break;
+
+    case AST::If:
+      compileBranch(node.sons[0], false, jumps);
+      ++nesting;
+      compileStm(node.sons[1]);
+      exit.push_back(emit(Jmp));
+      patch(jumps);
+      compileStm(node.sons[2]);
+      --nesting;
+      patch(exit);
+      break;
+
+    // Loops are rotated, so that a single conditional jump is executed
+    // on every iteration.
+    case AST::Whl:
+      exit.push_back(emit(Jmp));
+      body = code.size();
+      ++nesting;
+      compileStm(node.sons[1]);
+      --nesting;
+      patch(exit);
+      temporaries = 0;
+      compileBranch(node.sons[0], true, jumps);
+      for(i = 0; i < jumps.size(); ++i){
+        code[jumps[i]].a = (int) body;
+      }
+      break;
+
+    case AST::Prn:
+      emit(Prn, compileAExp(node.sons[0]));
+      break;
+
+    case AST::In:
+      emit(In, tree->nodes[node.sons[0]].value.var);
+      define(tree->nodes[node.sons[0]].value.var);
+      break;
+
+    default:
+      cerr << "[Bytecode::compileStm]: Unrecognized statement opcode value: "
+           << node.opcode.statement << "." << endl;
+  }
+}
+
+
+/** An arithmetic expression is compiled into the given register.
+ * @param[in]  n           Arithmetic expression to be compiled
+ * @param[in]  dst         Destination register
+ */
+void Bytecode::compileAExp(AST::Index n, int dst)
+{
+  const AST::Node &node = tree->nodes[n];
+  int a, b;
+
+  switch(node.opcode.arithmetic){
+    case AST::Num: emit(Ldi, dst, node.value.num); return;
+    case AST::Var: emit(Mov, dst, node.value.var); return;
+    case AST::Id:  emit(Mov, dst, compileAExp(node.sons[0])); return;
+    case AST::Opp: emit(Opp, dst, compileAExp(node.sons[0])); return;
+    default: break;
+  }
+
+  a = compileAExp(node.sons[0]);
+  b = compileAExp(node.sons[1]);
+  switch(node.opcode.arithmetic){
+    case AST::Sum: emit(Sum, dst, a, b); break;
+    case AST::Sub: emit(Sub, dst, a, b); break;
+    case AST::Mul: emit(Mul, dst, a, b); break;
+    case AST::Div: emit(Div, dst, a, b); break;
+    case AST::Rem: emit(Rem, dst, a, b); break;
+    case AST::Pow: emit(Pow, dst, a, b); break;
+    default:
+      cerr << "[Bytecode::compileAExp]: Unrecognized arithmetic opcode "
+           << "value: " << node.opcode.arithmetic << "." << endl;
+  }
+}
+
+
+/** An arithmetic expression is compiled into any register.
+ * Variables are not copied, their own register is returned instead.
+ * @param[in]  n           Arithmetic expression to be compiled
+ * @retval     int         Register holding the value
+ */
+int Bytecode::compileAExp(AST::Index n)
+{
+  const AST::Node &node = tree->nodes[n];
+  int dst;
+
+  if(node.opcode.arithmetic == AST::Var){
+    return node.value.var;
+  }
+
+  dst = temporary();
+  compileAExp(n, dst);
+
+  return dst;
+}
+
+
+/** A boolean expression is compiled into the given register.
+ * Register will contain 1 if the expression is true, 0 otherwise.
+ * @param[in]  n           Boolean expression to be compiled
+ * @param[in]  dst         Destination register
+ */
+void Bytecode::compileBExp(AST::Index n, int dst)
+{
+  const AST::Node &node = tree->nodes[n];
+  int a, b;
+
+  switch(node.opcode.boolean){
+    case AST::Bool:
+      emit(Ldi, dst, node.value.boolean ? 1 : 0);
+      return;
+
+    case AST::Not:
+      a = temporary();
+      compileBExp(node.sons[0], a);
+      emit(Not, dst, a);
+      return;
+
+    case AST::And: case AST::Or:   case AST::Xor:
+    case AST::Nand: case AST::Nor: case AST::Xnor:
+      a = temporary();
+      b = temporary();
+      compileBExp(node.sons[0], a);
+      compileBExp(node.sons[1], b);
+      break;
+
+    default:
+      a = compileAExp(node.sons[0]);
+      b = compileAExp(node.sons[1]);
+  }
+
+  switch(node.opcode.boolean){
+    case AST::And:  emit(And, dst, a, b); break;
+    case AST::Or:   emit(Or,  dst, a, b); break;
+    case AST::Xor:  emit(Xor, dst, a, b); break;
+    case AST::Nand: emit(And, dst, a, b); emit(Not, dst, dst); break;
+    case AST::Nor:  emit(Or,  dst, a, b); emit(Not, dst, dst); break;
+    case AST::Xnor: emit(Xor, dst, a, b); emit(Not, dst, dst); break;
+    case AST::Lt:   emit(Lt,  dst, a, b); break;
+    case AST::Leq:  emit(Leq, dst, a, b); break;
+    case AST::Eq:   emit(Eq,  dst, a, b); break;
+    case AST::Geq:  emit(Geq, dst, a, b); break;
+    case AST::Gt:   emit(Gt,  dst, a, b); break;
+    case AST::Neq:  emit(Neq, dst, a, b); break;
+    default:
+      cerr << "[Bytecode::compileBExp]: Unrecognized boolean opcode value: "
+           << node.opcode.boolean << "." << endl;
+  }
+}
+
+
+/** A boolean expression is compiled into a conditional jump.
+ * Jumps are taken when the expression evaluates to the given value,
+ * otherwise execution falls through. Targets of the emitted jumps are
+ * left to be patched by the caller.
+ * @param[in]  n           Boolean expression to be compiled
+ * @param[in]  when        Value which makes the jump to be taken
+ * @param[out] jumps       Addresses of the emitted jumps
+ */
+void Bytecode::compileBranch(AST::Index n, bool when, vector<size_t> &jumps)
+{
+  const AST::Node &node = tree->nodes[n];
+  vector<size_t> fall;
+  int a, b;
+
+  switch(node.opcode.boolean){
+    case AST::Bool:
+      if(node.value.boolean == when){ jumps.push_back(emit(Jmp)); }
+      return;
+
+    case AST::Not:
+      compileBranch(node.sons[0], !when, jumps);
+      return;
+
+    // Short-circuit evaluation: expressions have no side effects.
+    case AST::And:
+      if(when){
+        compileBranch(node.sons[0], false, fall);
+        compileBranch(node.sons[1], true, jumps);
+        patch(fall);
+      }
+      else{
+        compileBranch(node.sons[0], false, jumps);
+        compileBranch(node.sons[1], false, jumps);
+      }
+      return;
+
+    case AST::Or:
+      if(when){
+        compileBranch(node.sons[0], true, jumps);
+        compileBranch(node.sons[1], true, jumps);
+      }
+      else{
+        compileBranch(node.sons[0], true, fall);
+        compileBranch(node.sons[1], false, jumps);
+        patch(fall);
+      }
+      return;
+
+    // Comparisons are fused with the jump.
+    case AST::Lt:  case AST::Leq: case AST::Eq:
+    case AST::Geq: case AST::Gt:  case AST::Neq:
+      a = compileAExp(node.sons[0]);
+      b = compileAExp(node.sons[1]);
+      switch(node.opcode.boolean){
+        case AST::Lt:  jumps.push_back(emit(when ? Jlt  : Jgeq, 0, a, b)); break;
+        case AST::Leq: jumps.push_back(emit(when ? Jleq : Jgt,  0, a, b)); break;
+        case AST::Eq:  jumps.push_back(emit(when ? Jeq  : Jneq, 0, a, b)); break;
+        case AST::Geq: jumps.push_back(emit(when ? Jgeq : Jlt,  0, a, b)); break;
+        case AST::Gt:  jumps.push_back(emit(when ? Jgt  : Jleq, 0, a, b)); break;
+        default:       jumps.push_back(emit(when ? Jneq : Jeq,  0, a, b)); break;
+      }
+      return;
+
+    default:
+      a = temporary();
+      compileBExp(n, a);
+      jumps.push_back(emit(when ? Jnz : Jz, 0, a));
+  }
+}
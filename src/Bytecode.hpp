@@ -0,0 +1,186 @@
+/** Bytecode compiler and virtual machine.
+ * Class handling the compilation of an abstract syntax tree into a
+ * compact, linear bytecode, and its concrete execution on a register
+ * based virtual machine.
+ *
+ * @file Bytecode.hpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#ifndef BYTECODE_HPP
+#define BYTECODE_HPP
+
+#include <vector>
+#include <string>
+
+#include "AbstractState.hpp"
+#include "AST.hpp"
+
+using namespace std;
+
+
+/** Class representing a compiled While program.
+ * Every variable of the program is kept in the register matching the
+ * slot assigned by the symbol resolution pass, and temporary values are
+ * kept in the registers which follow the variables. Control structures
+ * are lowered into jumps, so that the program can be run by a tight
+ * interpreter loop, without any recursion and without any lookup by
+ * name.
+ */
+class Bytecode
+{
+  public:
+  /** Type representing an operation of the virtual machine.
+   * Unless otherwise stated, operand a is the destination register,
+   * operands b and c are the source registers.
+   */
+  typedef enum{
+    Ldi,           ///< Load the immediate value b into register a
+    Mov,           ///< Register copy
+    Opp,           ///< Opposite
+    Sum,           ///< Sum
+    Sub,           ///< Subtraction
+    Mul,           ///< Multiplication
+    Div,           ///< Integer division
+    Rem,           ///< Rest of the integer division
+    Pow,           ///< Raise to the power
+    Not,           ///< Logical negation
+    And,           ///< Logical conjunction
+    Or,            ///< Logical disjunction
+    Xor,           ///< Logical exclusive disjunction
+    Lt,            ///< 'Less than' comparison
+    Leq,           ///< 'Less than or equal to' comparison
+    Eq,            ///< 'Equal to' comparison
+    Geq,           ///< 'Greater than or equal to' comparison
+    Gt,            ///< 'Greater than' comparison
+    Neq,           ///< 'Not equal to' comparison
+    Jmp,           ///< Unconditional jump to a
+    Jz,            ///< Jump to a if register b is zero
+    Jnz,           ///< Jump to a if register b is not zero
+    Jlt,           ///< Jump to a if register b is less than register c
+    Jleq,          ///< Jump to a if b is less than or equal to c
+    Jeq,           ///< Jump to a if b is equal to c
+    Jgeq,          ///< Jump to a if b is greater than or equal to c
+    Jgt,           ///< Jump to a if b is greater than c
+    Jneq,          ///< Jump to a if b is not equal to c
+    Prn,           ///< Register a is printed
+    In,            ///< Register a is read from the standard input
+    Def,           ///< Variable a is marked as assigned
+    Hlt            ///< Execution is terminated
+  } OpType;
+
+
+  /** Constructor of a compiled program.
+   * The given abstract syntax tree is compiled into bytecode.
+   * @param[in]  program     Abstract syntax tree of the program, whose
+   *                         symbols have already been resolved
+   */
+  Bytecode(const AST *program);
+
+
+  /** Compiled program is executed starting from the zero state.
+   * Every variable is initialized to zero, but only the assigned ones
+   * are stored in the final state, as the tree walking interpreter does.
+   * @retval     AbstractState State containing the result of the
+   *                         (concrete) computation
+   */
+  AbstractState<int> run();
+
+
+  /** Number of instructions of the compiled program is returned.
+   * @retval     size_t      Number of instructions
+   */
+  size_t size();
+
+
+  private:
+  /** Type representing a single instruction. */
+  typedef struct{
+    OpType op;          ///< Operation
+    int    a;           ///< First operand
+    int    b;           ///< Second operand
+    int    c;           ///< Third operand
+  } Instruction;
+
+  const AST          *tree;        ///< Program being compiled
+  vector<Instruction> code;        ///< Compiled program
+  vector<string>      variables;   ///< Name of the variable in each slot
+  int                 temporaries; ///< First free temporary register
+  int                 registers;   ///< Number of needed registers
+  vector<bool>        assigned;    ///< True for the variables surely
+                                   ///<  assigned when execution halts
+  unsigned int        nesting;     ///< Number of enclosing conditionals
+                                   ///<  and loops being compiled
+
+
+  /** An instruction is appended to the program.
+   * @param[in]  op          Operation
+   * @param[in]  a           First operand
+   * @param[in]  b           Second operand
+   * @param[in]  c           Third operand
+   * @retval     size_t      Address of the instruction
+   */
+  size_t emit(OpType op, int a = 0, int b = 0, int c = 0);
+
+
+  /** Jumps in the given list are set to target the next instruction.
+   * @param[in]  jumps       Addresses of the jumps to be patched
+   */
+  void patch(vector<size_t> &jumps);
+
+
+  /** A new temporary register is allocated.
+   * @retval     int         Index of the temporary register
+   */
+  int temporary();
+
+
+  /** A variable is recorded as assigned by the statement being compiled.
+   * Statements outside of conditionals and loops are surely executed if
+   * the program halts, so their variables are known to be assigned;
+   * elsewhere, a Def instruction marks the variable at run time, unless
+   * it has already been surely assigned.
+   * @param[in]  var         Slot of the assigned variable
+   */
+  void define(int var);
+
+
+  /** A statement is compiled.
+   * @param[in]  n           Statement to be compiled
+   */
+  void compileStm(AST::Index n);
+
+
+  /** An arithmetic expression is compiled into the given register.
+   * @param[in]  n           Arithmetic expression to be compiled
+   * @param[in]  dst         Destination register
+   */
+  void compileAExp(AST::Index n, int dst);
+
+
+  /** An arithmetic expression is compiled into any register.
+   * Variables are not copied, their own register is returned instead.
+   * @param[in]  n           Arithmetic expression to be compiled
+   * @retval     int         Register holding the value
+   */
+  int compileAExp(AST::Index n);
+
+
+  /** A boolean expression is compiled into the given register.
+   * Register will contain 1 if the expression is true, 0 otherwise.
+   * @param[in]  n           Boolean expression to be compiled
+   * @param[in]  dst         Destination register
+   */
+  void compileBExp(AST::Index n, int dst);
+
+
+  /** A boolean expression is compiled into a conditional jump.
+   * Jumps are taken when the expression evaluates to the given value,
+   * otherwise execution falls through. Targets of the emitted jumps are
+   * left to be patched by the caller.
+   * @param[in]  n           Boolean expression to be compiled
+   * @param[in]  when        Value which makes the jump to be taken
+   * @param[out] jumps       Addresses of the emitted jumps
+   */
+  void compileBranch(AST::Index n, bool when, vector<size_t> &jumps);
+};
+#endif
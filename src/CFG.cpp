@@ -0,0 +1,132 @@
+/** Control flow graph.
+ * Class handling the control flow graph of a program, built from its
+ * abstract syntax tree, and a worklist fixpoint engine running on it.
+ *
+ * @file CFG.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#include <iostream>
+
+#include "CFG.hpp"
+
+
+/** Constructor of a control flow graph.
+ * @param[in]  program     Abstract syntax tree of the program, whose
+ *                         symbols have already been resolved
+ */
+CFG::CFG(const AST *program)
+{
+  tree = program;
+  exitBlock = build(program->root, block());
+}
+
+
+/** Number of blocks is returned.
+ * @retval     size_t      Number of blocks
+ */
+size_t CFG::size() const
+{
+  return blocks.size();
+}
+
+
+/** A new, empty block is appended to the graph.
+ * @retval     Index       Index of the new block
+ */
+AST::Index CFG::block()
+{
+  Block b;
+
+  b.head = false;
+  b.end  = AST::None;
+  blocks.push_back(b);
+
+  return blocks.size() - 1;
+}
+
+
+/** An edge is added to the graph.
+ * @param[in]  source      Block the edge comes from
+ * @param[in]  target      Block the edge goes to
+ * @param[in]  guard       Guard of the edge, if any
+ */
+void CFG::edge(AST::Index source, AST::Index target, AST::Index guard)
+{
+  Edge e;
+
+  e.source = source;
+  e.guard  = guard;
+  blocks[target].predecessors.push_back(e);
+  blocks[source].successors.push_back(target);
+}
+
+
+/** A statement is added to the graph.
+ * Blocks are created in weak topological order: branches come before
+ * the block joining them, loop bodies come right after their head and
+ * before the block following the loop.
+ * @param[in]  n           Statement to be added
+ * @param[in]  current     Block where control is before the statement
+ * @retval     Index       Block where control is after the statement
+ */
+AST::Index CFG::build(AST::Index n, AST::Index current)
+{
+  const AST::Node &node = tree->nodes[n];
+  AST::Index guard, negation, first, second, join, head, after;
+  size_t i;
+
+  // If node is not a statement, just keep the current block.
+  if(node.type != AST::Stm){ return current; }
+
+  switch(node.opcode.statement){
+    // Print is kept only to prune the variables which die there, as the
+    // tree does.
+    case AST::Asn:
+    case AST::In:
+    case AST::Prn:
+      blocks[current].statements.push_back(n);
+      return current;
+
+    case AST::Skp:
+      return current;
+
+    case AST::Blk:
+      for(i = 0; i < tree->sequences[node.value.block].size(); ++i){
+        current = build(tree->sequences[node.value.block][i], current);
+      }
+      return current;
+
+    case AST::If:
+      guard    = node.sons[0];
+      negation = tree->nodes[guard].negation;
+      first    = block();
+      second   = block();
+      edge(current, first,  guard);
+      edge(current, second, negation);
+      first    = build(node.sons[1], first);
+      second   = build(node.sons[2], second);
+      join     = block();
+      edge(first,  join);
+      edge(second, join);
+      return join;
+
+    case AST::Whl:
+      guard    = node.sons[0];
+      negation = tree->nodes[guard].negation;
+      head     = block();
+      edge(current, head);
+      first    = block();
+      edge(head, first, guard);
+      edge(build(node.sons[1], first), head);
+      blocks[head].head = true;
+      blocks[head].end  = blocks.size();
+      after    = block();
+      edge(head, after, negation);
+      return after;
+
+    default:
+      cerr << "[CFG::build]: Unrecognized statement opcode value: "
+           << node.opcode.statement << "." << endl;
+      return current;
+  }
+}
@@ -0,0 +1,231 @@
+/** Control flow graph.
+ * Class handling the control flow graph of a program, built from its
+ * abstract syntax tree, and a worklist fixpoint engine running on it.
+ *
+ * @file CFG.hpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#ifndef CFG_HPP
+#define CFG_HPP
+
+#include <vector>
+
+#include "AbstractState.hpp"
+#include "AST.hpp"
+
+using namespace std;
+
+
+/** Class representing the control flow graph of a program.
+ * Every block holds a sequence of assignments and inputs, and is
+ * entered through edges which may be labelled by a guard. Blocks are
+ * numbered in a weak topological order: every loop head is followed by
+ * the blocks of its body, which form its component, so that the graph
+ * can be solved by the recursive iteration strategy. Widening is only
+ * applied at loop heads, and only blocks whose input may have changed
+ * are evaluated again.
+ */
+class CFG
+{
+  public:
+  /** Constructor of a control flow graph.
+   * @param[in]  program     Abstract syntax tree of the program, whose
+   *                         symbols have already been resolved
+   */
+  CFG(const AST *program);
+
+
+  /** Number of blocks is returned.
+   * @retval     size_t      Number of blocks
+   */
+  size_t size() const;
+
+
+  /** Control flow graph is interpreted from the initial state.
+   * Type of (abstract) interpretation is parametric. Once the fixpoint
+   * is reached, the whole graph is narrowed by as many descending
+   * iterations as the strategy of the tree allows: every block is
+   * evaluated again in order, with no widening, starting from states
+   * which are already sound, and a fixed number of rounds is performed.
+   * @retval     AbstractState Final state
+   */
+  template <typename D>
+  AbstractState<D> interpret() const
+  {
+    vector< AbstractState<D> > in(blocks.size()), out(blocks.size());
+    vector<bool> reached(blocks.size(), false);
+    vector<bool> stale(blocks.size(), false);
+    vector<unsigned int> iterations(blocks.size(), 0);
+    AST::Index b;
+    unsigned int i;
+
+    in[0]    = AbstractState<D>(tree->variables());
+    stale[0] = true;
+    solve(0, blocks.size(), in, out, reached, stale, iterations);
+    for(i = 0; i < tree->strategy.narrowing; ++i){
+      for(b = 1; b < blocks.size(); ++b){
+        evaluate(b, in, out, reached, stale, iterations, true);
+      }
+    }
+
+    return reached[exitBlock] ? out[exitBlock] : AbstractState<D>();
+  }
+
+
+  private:
+  /** Type representing an edge entering a block. */
+  typedef struct{
+    AST::Index source;            ///< Block the edge comes from
+    AST::Index guard;             ///< Guard of the edge, None if missing
+  } Edge;
+
+  /** Type representing a basic block. */
+  typedef struct{
+    vector<AST::Index> statements;   ///< Statements, in execution order
+    vector<Edge>       predecessors; ///< Edges entering the block
+    vector<AST::Index> successors;   ///< Blocks reached by the block
+    bool               head;         ///< True if the block is a loop head
+    AST::Index         end;          ///< First block after the component
+                                     ///<  of a loop head
+  } Block;
+
+
+  const AST    *tree;     ///< Program the graph is built from
+  vector<Block> blocks;   ///< Blocks, in weak topological order
+  AST::Index    exitBlock;///< Block reached at the end of the program
+
+
+  /** A new, empty block is appended to the graph.
+   * @retval     Index       Index of the new block
+   */
+  AST::Index block();
+
+
+  /** An edge is added to the graph.
+   * @param[in]  source      Block the edge comes from
+   * @param[in]  target      Block the edge goes to
+   * @param[in]  guard       Guard of the edge, if any
+   */
+  void edge(AST::Index source, AST::Index target,
+            AST::Index guard = AST::None);
+
+
+  /** A statement is added to the graph.
+   * @param[in]  n           Statement to be added
+   * @param[in]  current     Block where control is before the statement
+   * @retval     Index       Block where control is after the statement
+   */
+  AST::Index build(AST::Index n, AST::Index current);
+
+
+  /** Blocks in the given range are stabilized.
+   * Range is a sequence of components of the weak topological order.
+   * Every loop head is evaluated again, together with its component,
+   * until its input does not change any more.
+   * @param[in]  from        First block of the range
+   * @param[in]  to          First block after the range
+   * @param[in,out] in       Input state of each block
+   * @param[in,out] out      Output state of each block
+   * @param[in,out] reached  True for blocks which have been evaluated
+   * @param[in,out] stale    True for blocks whose input may have changed
+   * @param[in,out] iterations Iterations performed on each loop head
+   */
+  template <typename D>
+  void solve(AST::Index from, AST::Index to,
+             vector< AbstractState<D> > &in, vector< AbstractState<D> > &out,
+             vector<bool> &reached, vector<bool> &stale,
+             vector<unsigned int> &iterations) const
+  {
+    AST::Index b;
+
+    b = from;
+    while(b < to){
+      if(blocks[b].head){
+        iterations[b] = 0;
+        while(stale[b]){
+          evaluate(b, in, out, reached, stale, iterations, false);
+          solve(b + 1, blocks[b].end, in, out, reached, stale, iterations);
+        }
+        b = blocks[b].end;
+      }
+      else{
+        if(stale[b]){
+          evaluate(b, in, out, reached, stale, iterations, false);
+        }
+        ++b;
+      }
+    }
+  }
+
+
+  /** A block is evaluated.
+   * Input state is the least upperbound of the output states of the
+   * predecessors, filtered by the guards of the edges. At loop heads,
+   * unless the graph is being narrowed, it is also joined with the
+   * previous input, and then widened after the delay and saturated
+   * after the budget of the strategy of the tree. If the output state
+   * changes, successors are marked as stale.
+   * @param[in]  b           Block to be evaluated
+   * @param[in,out] in       Input state of each block
+   * @param[in,out] out      Output state of each block
+   * @param[in,out] reached  True for blocks which have been evaluated
+   * @param[in,out] stale    True for blocks whose input may have changed
+   * @param[in,out] iterations Iterations performed on each loop head
+   * @param[in]  descending  True if the graph is being narrowed
+   */
+  template <typename D>
+  void evaluate(AST::Index b,
+                vector< AbstractState<D> > &in,
+                vector< AbstractState<D> > &out,
+                vector<bool> &reached, vector<bool> &stale,
+                vector<unsigned int> &iterations, bool descending) const
+  {
+    const Block &block = blocks[b];
+    AbstractState<D> s, incoming;
+    bool entered = false, changed;
+    unsigned int i;
+
+    stale[b] = false;
+
+    // Input state is computed, entry block keeps the initial one.
+    if(b != 0){
+      for(i = 0; i < block.predecessors.size(); ++i){
+        const Edge &e = block.predecessors[i];
+        if(!reached[e.source]){ continue; }
+        s = out[e.source];
+        if(e.guard != AST::None){
+          tree->B(tree->nodes[e.guard], s);
+          tree->prune(e.guard, s);
+        }
+        if(entered){ incoming.join(s); }
+        else{ incoming = move(s); entered = true; }
+      }
+      if(!entered){ return; }
+      if(block.head && reached[b] && !descending){
+        incoming.join(in[b]);
+        ++iterations[b];
+        if(iterations[b] > tree->strategy.delay){ incoming.widen(in[b]); }
+        if(tree->strategy.budget && iterations[b] > tree->strategy.budget){
+          incoming.saturate(in[b]);
+        }
+      }
+      in[b] = move(incoming);
+    }
+
+    // Statements are interpreted in sequence.
+    s = in[b];
+    for(i = 0; i < block.statements.size(); ++i){
+      tree->interpret(block.statements[i], s);
+    }
+
+    changed    = !reached[b] || out[b] != s;
+    out[b]     = move(s);
+    reached[b] = true;
+    if(changed){
+      for(i = 0; i < block.successors.size(); ++i){
+        stale[block.successors[i]] = true;
+      }
+    }
+  }
+};
+#endif
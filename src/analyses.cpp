@@ -0,0 +1,90 @@
+/** Analyses over the available abstract domains.
+ * Type describing the analysis of a program over one domain, shared by
+ * the interpreter and the benchmarks, along with the functions building
+ * every analysis of Domains and picking the selected ones.
+ *
+ * @file analyses.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#include "analyses.hpp"
+
+/// Column at which the descriptions of the options start.
+#define INDENT 19
+
+/// Width of a line of the help text.
+#define WIDTH 80
+
+
+
+/** Analyses over the selected domains are picked.
+ * @param[in]  available     Every available analysis
+ * @param[in]  selected      Keys of the selected domains, the standard
+ *                           ones are picked if empty
+ * @param[out] analyses      Selected analyses, in the order of the
+ *                           available ones
+ * @param[out] unknown       First selected key naming no domain, if any
+ * @retval     bool          False if an unknown domain was selected
+ */
+bool select(const vector<Analysis> &available,
+            const vector<string> &selected, vector<Analysis> &analyses,
+            string &unknown)
+{
+  unsigned int i, j;
+
+  // Every selected key must name an available domain.
+  for(i = 0; i < selected.size(); ++i){
+    for(j = 0; j < available.size(); ++j){
+      if(selected[i] == available[j].key){ break; }
+    }
+    if(j == available.size()){
+      unknown = selected[i];
+      return false;
+    }
+  }
+
+  // Standard domains are analyzed if none is selected.
+  for(i = 0; i < available.size(); ++i){
+    bool chosen = selected.empty() && available[i].standard;
+
+    for(j = 0; j < selected.size() && !chosen; ++j){
+      chosen = (selected[j] == available[i].key);
+    }
+    if(chosen){ analyses.push_back(available[i]); }
+  }
+
+  return true;
+}
+
+
+
+/** Keys of the given analyses are listed for a help text.
+ * Keys are comma separated and wrapped at 80 columns; following lines
+ * are indented as the descriptions of the options.
+ * @param[in]  analyses      Analyses whose keys are listed
+ * @param[in]  column        Column the list starts from
+ * @retval     string        List of keys
+ */
+string keys(const vector<Analysis> &analyses, unsigned int column)
+{
+  string list;
+  unsigned int i;
+
+  for(i = 0; i < analyses.size(); ++i){
+    string key = string(analyses[i].key)
+                 + ((i + 1 < analyses.size()) ? "," : "");
+
+    // Key is moved to a new line if it does not fit in the current one.
+    if(i > 0 && column + 1 + key.size() >= WIDTH){
+      list  += "\n" + string(INDENT, ' ');
+      column = INDENT;
+    }
+    else if(i > 0){
+      list   += " ";
+      column += 1;
+    }
+    list   += key;
+    column += key.size();
+  }
+
+  return list;
+}
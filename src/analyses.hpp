@@ -0,0 +1,111 @@
+/** Analyses over the available abstract domains.
+ * Type describing the analysis of a program over one domain, shared by
+ * the interpreter and the benchmarks, along with the functions building
+ * every analysis of Domains and picking the selected ones.
+ *
+ * @file analyses.hpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#ifndef ANALYSES_HPP
+#define ANALYSES_HPP
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "domains.hpp"
+#include "AbstractState.hpp"
+#include "AST.hpp"
+#include "CFG.hpp"
+
+using namespace std;
+
+
+/** Type representing the analysis of a program over a domain. */
+typedef struct{
+  const char *key;              ///< Key selecting the analysis
+  const char *name;             ///< Name of the domain
+  bool standard;                ///< True if run when none is selected
+  string (*run)(const AST *program, const CFG *graph);
+                                ///< Analysis, returning the result
+  void (*counters)(unsigned long &copies, unsigned long &comparisons);
+                                ///< Statistics about the analysis
+} Analysis;
+
+
+
+/** Program is analyzed over the given abstract domain.
+ * Abstract syntax tree and control flow graph are only read, so that
+ * many analyses can share them concurrently.
+ * @param[in]  program       Abstract syntax tree of the program
+ * @param[in]  graph         Control flow graph of the program, NULL if
+ *                           the abstract syntax tree shall be used
+ * @retval     string        Textual representation of the final state
+ */
+template <typename D>
+string analyze(const AST *program, const CFG *graph)
+{
+  ostringstream out;
+  AbstractState<D> state = (NULL == graph) ? program->interpret<D>()
+                                           : graph->interpret<D>();
+
+  state.dump(out);
+  return out.str();
+}
+
+
+
+/** Statistics about the states of the given abstract domain are read.
+ * @param[out] copies        Number of copies of states
+ * @param[out] comparisons   Number of full comparisons between states
+ */
+template <typename D>
+void counters(unsigned long &copies, unsigned long &comparisons)
+{
+  copies      = AbstractState<D>::copies;
+  comparisons = AbstractState<D>::comparisons;
+}
+
+
+
+/** Analysis of every domain in the list is built.
+ * Analyses are instantiated at compile time, but only the selected ones
+ * are run.
+ * @param[in]  domains       List of abstract domains
+ * @retval     vector        Analysis of each domain, in the same order
+ */
+template <typename... Ds>
+vector<Analysis> registry(DomainList<Ds...> domains)
+{
+  (void) domains;
+  return {{DomainTraits<Ds>::key, DomainTraits<Ds>::name,
+           DomainTraits<Ds>::standard, analyze<Ds>, counters<Ds>}...};
+}
+
+
+
+/** Analyses over the selected domains are picked.
+ * @param[in]  available     Every available analysis
+ * @param[in]  selected      Keys of the selected domains, the standard
+ *                           ones are picked if empty
+ * @param[out] analyses      Selected analyses, in the order of the
+ *                           available ones
+ * @param[out] unknown       First selected key naming no domain, if any
+ * @retval     bool          False if an unknown domain was selected
+ */
+bool select(const vector<Analysis> &available,
+            const vector<string> &selected, vector<Analysis> &analyses,
+            string &unknown);
+
+
+
+/** Keys of the given analyses are listed for a help text.
+ * Keys are comma separated and wrapped at 80 columns; following lines
+ * are indented as the descriptions of the options.
+ * @param[in]  analyses      Analyses whose keys are listed
+ * @param[in]  column        Column the list starts from
+ * @retval     string        List of keys
+ */
+string keys(const vector<Analysis> &analyses, unsigned int column);
+
+#endif
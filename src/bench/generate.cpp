@@ -0,0 +1,50 @@
+/** Generator of synthetic While programs.
+ * Program printing a While program of the given shape, to be analyzed
+ * or executed as a workload.
+ *
+ * Usage: generate [options], see generate --help.
+ *
+ * @file generate.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+#include "generator.hpp"
+
+using namespace std;
+
+
+/** Main function.
+ * Program is printed on the standard output.
+ * @param[in]  argc        Number of arguments
+ * @param[in]  argv        Array of arguments
+ * @retval     int         Exit status
+ */
+int main(int argc, char *argv[])
+{
+  Generator::Parameters parameters = Generator::defaults;
+  int i;
+
+  for(i = 1; i < argc; ++i){
+    if(Generator::option(argc, argv, i, parameters)){ continue; }
+
+    if(strcmp("--help", argv[i]) != 0 && strcmp("-h", argv[i]) != 0){
+      cerr << "[Generate]: Unknown option '" << argv[i] << "'." << endl;
+    }
+    cout
+    << "Generator of synthetic While programs\n"
+    << "----------------------------------\n"
+    << "Usage: generate [options]\n\n"
+    << "List of options:\n"
+    << Generator::help()
+    << "  -h, --help       Print this help and exit\n";
+    return (strcmp("--help", argv[i]) == 0 || strcmp("-h", argv[i]) == 0)
+           ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  cout << Generator(parameters).generate();
+
+  return EXIT_SUCCESS;
+}
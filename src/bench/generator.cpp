@@ -0,0 +1,290 @@
+/** Generator of synthetic While programs.
+ * Class building random, yet reproducible, While programs whose size and
+ * shape are given by a few parameters, so that the analyzer can be
+ * measured on workloads of any size.
+ *
+ * @file generator.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <sstream>
+
+#include "generator.hpp"
+
+
+/** Default shape: a mid-sized program, nested three deep at most. */
+const Generator::Parameters Generator::defaults = {
+  16, 1000, 3, 3, 15, 10, 2, {4, 3, 2, 1, 1, 1}, 42
+};
+
+
+/** Generator parameter is read from the command line, if any.
+ * @param[in]  argc        ARGument Counter
+ * @param[in]  argv        ARGument Vector
+ * @param[in]  i           Index of the current argument, moved past
+ *                         the ones which were read
+ * @param[out] parameters  Parameters to be updated
+ * @retval     bool        True if the argument was a generator one
+ */
+bool Generator::option(int argc, char *argv[], int &i, Parameters &parameters)
+{
+  const struct{
+    const char   *name;
+    unsigned int *value;
+  } numbers[] = {
+    {"--variables", &parameters.variables},
+    {"--statements", &parameters.statements},
+    {"--depth", &parameters.depth},
+    {"--trips", &parameters.trips},
+    {"--branches", &parameters.branches},
+    {"--loops", &parameters.loops},
+    {"--operators", &parameters.operators},
+    {"--seed", &parameters.seed}
+  };
+  unsigned int j;
+
+  if(i + 1 >= argc){ return false; }
+
+  // Numeric parameters.
+  for(j = 0; j < sizeof(numbers) / sizeof(numbers[0]); ++j){
+    if(strcmp(numbers[j].name, argv[i]) == 0){
+      *numbers[j].value = strtoul(argv[++i], NULL, 10);
+      return true;
+    }
+  }
+
+  // Weights of the arithmetic operators.
+  if(strcmp("--mix", argv[i]) == 0){
+    istringstream weights(argv[++i]);
+    string weight;
+
+    for(j = 0; j < 6; ++j){
+      parameters.mix[j] = getline(weights, weight, ',')
+                          ? strtoul(weight.c_str(), NULL, 10) : 0;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+
+/** Help about the generator parameters is provided.
+ * @retval     const char * Lines describing every generator option
+ */
+const char *Generator::help()
+{
+  return
+  "  --variables N    Use N variables (default 16)\n"
+  "  --statements N   Generate about N statements (default 1000)\n"
+  "  --depth N        Nest loops and branches up to N deep (default 3)\n"
+  "  --trips N        Iterate every loop N times (default 3)\n"
+  "  --branches P     Make P% of the statements branches (default 15)\n"
+  "  --loops P        Make P% of the statements loops (default 10)\n"
+  "  --operators N    Use up to N operators in an expression (default 2)\n"
+  "  --mix W,W,W,W,W,W\n"
+  "                   Weigh +, -, *, /, %, ^ by W (default 4,3,2,1,1,1)\n"
+  "  --seed N         Seed the random generator with N (default 42)\n";
+}
+
+
+/** Constructor of a generator.
+ * @param[in]  parameters  Shape of the generated programs
+ */
+Generator::Generator(const Parameters &parameters)
+{
+  this->parameters = parameters;
+  remaining        = 0;
+
+  // At least a variable is needed to be assigned.
+  if(this->parameters.variables < 1){ this->parameters.variables = 1; }
+}
+
+
+/** Program is generated.
+ * Every variable is initialized first, then statements are generated
+ * until the budget runs out. Blocks are never empty, hence the budget
+ * may be exceeded by a few statements.
+ * @retval     string      Source code of the program
+ */
+string Generator::generate()
+{
+  unsigned int i;
+
+  random.seed(parameters.seed);
+  remaining = parameters.statements;
+  source.clear();
+
+  for(i = 0; i < parameters.variables; ++i){
+    source += "v" + to_string(i) + " := " + to_string(draw(0, 9)) + ";\n";
+    if(remaining > 0){ --remaining; }
+  }
+  while(remaining > 0){
+    statement(0, 0);
+  }
+
+  return source;
+}
+
+
+/** Random number in the given range is drawn.
+ * @param[in]  low         Lowest value
+ * @param[in]  high        Highest value, included
+ * @retval     unsigned int Random number
+ */
+unsigned int Generator::draw(unsigned int low, unsigned int high)
+{
+  return uniform_int_distribution<unsigned int>(low, high)(random);
+}
+
+
+/** Block of statements is generated.
+ * @param[in]  size        Maximum number of statements
+ * @param[in]  loops       Number of enclosing loops
+ * @param[in]  nesting     Number of enclosing loops and branches
+ */
+void Generator::block(unsigned int size, unsigned int loops,
+                      unsigned int nesting)
+{
+  do{
+    statement(loops, nesting);
+  } while(--size > 0 && remaining > 0);
+}
+
+
+/** Statement is generated.
+ * Loops count down a counter named after their nesting depth, so that
+ * nested loops never share it. Nesting is bounded, otherwise blocks
+ * would keep opening new ones until the budget runs out.
+ * @param[in]  loops       Number of enclosing loops
+ * @param[in]  nesting     Number of enclosing loops and branches
+ */
+void Generator::statement(unsigned int loops, unsigned int nesting)
+{
+  unsigned int kind = (nesting < parameters.depth) ? draw(0, 99) : 100;
+  string margin(2 * nesting, ' ');
+
+  // Loop, along with the initialization and update of its counter.
+  if(kind < parameters.loops && remaining >= 3){
+    string counter = "i" + to_string(loops);
+
+    remaining -= 3;
+    source += margin + counter + " := " + to_string(parameters.trips)
+            + ";\n" + margin + "while " + counter + " > 0 do(\n";
+    block(draw(1, 8), loops + 1, nesting + 1);
+    source += margin + "  " + counter + " := " + counter + " - 1;\n"
+            + margin + ");\n";
+  }
+
+  // Branch.
+  else if(kind < parameters.loops + parameters.branches && remaining >= 3){
+    --remaining;
+    source += margin + "if ";
+    boolean();
+    source += " then(\n";
+    block(draw(1, 4), loops, nesting + 1);
+    source += margin + ") else (\n";
+    block(draw(1, 4), loops, nesting + 1);
+    source += margin + ");\n";
+  }
+
+  // Assignment.
+  else{
+    if(remaining > 0){ --remaining; }
+    source += margin;
+    variable();
+    source += " := ";
+    arithmetic(draw(0, parameters.operators));
+    source += ";\n";
+  }
+}
+
+
+/** Arithmetic expression is generated.
+ * Divisors are mapped into [2; 14], factors into [-9; 9], bases into
+ * [-3; 3] and exponents are small constants, so that no value overflows
+ * when the program is executed, however many times loops repeat it.
+ * @param[in]  operators   Maximum number of operators
+ */
+void Generator::arithmetic(unsigned int operators)
+{
+  static const char *symbols[] = {" + ", " - ", " * ", " / ", " % ", " ^ "};
+  unsigned int total = 0, weight, left, i;
+
+  for(i = 0; i < 6; ++i){ total += parameters.mix[i]; }
+
+  // Leaf: variable or constant.
+  if(operators == 0 || total == 0){
+    if(draw(0, 1) == 0){ variable(); }
+    else{ source += to_string(draw(0, 9)); }
+    return;
+  }
+
+  // Operator is drawn according to its weight.
+  weight = draw(0, total - 1);
+  for(i = 0; weight >= parameters.mix[i]; ++i){
+    weight -= parameters.mix[i];
+  }
+  left = draw(0, operators - 1);
+
+  source += "(";
+  switch(i){
+    case 2: case 5:
+      source += "(";
+      arithmetic(left);
+      source += (i == 2) ? " % 10)" : " % 4)";
+      break;
+    default:
+      arithmetic(left);
+      break;
+  }
+  source += symbols[i];
+  switch(i){
+    case 2:
+      source += "(";
+      arithmetic(operators - 1 - left);
+      source += " % 10)";
+      break;
+    case 3: case 4:
+      source += "(";
+      arithmetic(operators - 1 - left);
+      source += " % 7 + 8)";
+      break;
+    case 5:
+      source += to_string(draw(0, 3));
+      break;
+    default:
+      arithmetic(operators - 1 - left);
+      break;
+  }
+  source += ")";
+}
+
+
+/** Boolean expression is generated.
+ * Comparisons are sometimes joined by a connective.
+ */
+void Generator::boolean()
+{
+  static const char *comparisons[] = {" < ", " <= ", " = ", " >= ", " > ",
+                                      " <> "};
+  static const char *connectives[] = {" and ", " or "};
+  unsigned int i, count = (draw(0, 3) == 0) ? 2 : 1;
+
+  for(i = 0; i < count; ++i){
+    if(i > 0){ source += connectives[draw(0, 1)]; }
+    source += "(";
+    variable();
+    source += comparisons[draw(0, 5)];
+    arithmetic(draw(0, 1));
+    source += ")";
+  }
+}
+
+
+/** Name of a random variable is generated. */
+void Generator::variable()
+{
+  source += "v" + to_string(draw(0, parameters.variables - 1));
+}
@@ -0,0 +1,121 @@
+/** Generator of synthetic While programs.
+ * Class building random, yet reproducible, While programs whose size and
+ * shape are given by a few parameters, so that the analyzer can be
+ * measured on workloads of any size.
+ *
+ * @file generator.hpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include <random>
+#include <string>
+
+using namespace std;
+
+
+/** Class representing a generator of synthetic While programs.
+ * Every generated program terminates and never divides by zero: loops
+ * count down a counter of their own, which the body never assigns, and
+ * divisors are forced to be positive. Factors and bases are reduced
+ * modulo small constants, so that values never overflow. Programs never
+ * read their input nor print, so that they can be executed concretely
+ * as well.
+ */
+class Generator
+{
+  public:
+  /** Type representing the shape of the generated programs. */
+  typedef struct{
+    unsigned int variables;     ///< Number of variables
+    unsigned int statements;    ///< Number of statements, roughly
+    unsigned int depth;         ///< Maximum nesting depth of loops and
+                                ///<  branches
+    unsigned int trips;         ///< Iterations of every loop
+    unsigned int branches;      ///< Percentage of branch statements
+    unsigned int loops;         ///< Percentage of loop statements
+    unsigned int operators;     ///< Maximum operators in an expression
+    unsigned int mix[6];        ///< Weights of +, -, *, /, %, ^
+    unsigned int seed;          ///< Seed of the random generator
+  } Parameters;
+
+
+  /** Default shape of the generated programs. */
+  static const Parameters defaults;
+
+
+  /** Generator parameter is read from the command line, if any.
+   * @param[in]  argc        ARGument Counter
+   * @param[in]  argv        ARGument Vector
+   * @param[in]  i           Index of the current argument, moved past
+   *                         the ones which were read
+   * @param[out] parameters  Parameters to be updated
+   * @retval     bool        True if the argument was a generator one
+   */
+  static bool option(int argc, char *argv[], int &i, Parameters &parameters);
+
+
+  /** Help about the generator parameters is provided.
+   * @retval     const char * Lines describing every generator option
+   */
+  static const char *help();
+
+
+  /** Constructor of a generator.
+   * @param[in]  parameters  Shape of the generated programs
+   */
+  Generator(const Parameters &parameters);
+
+
+  /** Program is generated.
+   * Same parameters always yield the same program.
+   * @retval     string      Source code of the program
+   */
+  string generate();
+
+
+  private:
+  Parameters parameters;        ///< Shape of the generated programs
+  mt19937 random;               ///< Random generator
+  unsigned int remaining;       ///< Statements still to be generated
+  string source;                ///< Source code being generated
+
+
+  /** Random number in the given range is drawn.
+   * @param[in]  low         Lowest value
+   * @param[in]  high        Highest value, included
+   * @retval     unsigned int Random number
+   */
+  unsigned int draw(unsigned int low, unsigned int high);
+
+
+  /** Block of statements is generated.
+   * @param[in]  size        Maximum number of statements
+   * @param[in]  loops       Number of enclosing loops
+   * @param[in]  nesting     Number of enclosing loops and branches
+   */
+  void block(unsigned int size, unsigned int loops, unsigned int nesting);
+
+
+  /** Statement is generated.
+   * @param[in]  loops       Number of enclosing loops
+   * @param[in]  nesting     Number of enclosing loops and branches
+   */
+  void statement(unsigned int loops, unsigned int nesting);
+
+
+  /** Arithmetic expression is generated.
+   * @param[in]  operators   Maximum number of operators
+   */
+  void arithmetic(unsigned int operators);
+
+
+  /** Boolean expression is generated. */
+  void boolean();
+
+
+  /** Name of a random variable is generated. */
+  void variable();
+};
+#endif
@@ -0,0 +1,286 @@
+/** Scaling benchmark of the While interpreter.
+ * Program generating synthetic programs of increasing size and measuring
+ * how long parsing, every abstract analysis and the concrete executions
+ * take on them, along with the memory they need.
+ *
+ * Usage: scaling [options], see scaling --help.
+ *
+ * Results are printed as comma separated values, one line per size and
+ * phase: statements, bytes of source code, phase, domain (analyses
+ * only), best time in seconds, statements per second and peak resident
+ * memory in KiB. Every phase runs in a process of its own, so that its
+ * peak memory is not hidden by the previous ones; it includes the memory
+ * of parsing, which every phase needs.
+ *
+ * @file scaling.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../AbstractState.hpp"
+#include "../AST.hpp"
+#include "../Bytecode.hpp"
+#include "../CFG.hpp"
+#include "../analyses.hpp"
+#include "../parser/parser.hpp"
+#include "generator.hpp"
+
+using namespace std;
+
+
+/** Type representing a phase to be measured. */
+typedef struct{
+  const char *phase;            ///< Name of the phase
+  const char *domain;           ///< Key of the domain, empty if none
+  string (*run)(const AST *program, const CFG *graph);
+                                ///< Phase, run on a parsed program
+} Phase;
+
+
+/** Program is executed by the tree walking interpreter.
+ * @param[in]  program       Abstract syntax tree of the program
+ * @param[in]  graph         Unused
+ * @retval     string        Empty string
+ */
+string execute(const AST *program, const CFG *graph)
+{
+  (void) graph;
+  program->execute();
+  return "";
+}
+
+
+/** Program is executed by the bytecode virtual machine.
+ * @param[in]  program       Abstract syntax tree of the program
+ * @param[in]  graph         Unused
+ * @retval     string        Empty string
+ */
+string run(const AST *program, const CFG *graph)
+{
+  (void) graph;
+  Bytecode(program).run();
+  return "";
+}
+
+
+/** Source code is parsed and optimized, as the interpreter does.
+ * @param[in]  source        Source code of the program
+ * @retval     AST *         Abstract syntax tree, NULL if empty
+ */
+static AST *prepare(const string &source)
+{
+  AST *program = parse(source.data(), source.size());
+
+  if(NULL != program){
+    program->resolve();
+    program->optimize();
+    AbstractState<Octagon>::setPacks(program->packs());
+  }
+
+  return program;
+}
+
+
+/** Phase is measured in a child process.
+ * Phase is repeated and the best time is kept. Line of results is
+ * printed by the child.
+ * @param[in]  source        Source code of the program
+ * @param[in]  statements    Number of statements of the program
+ * @param[in]  phase         Phase to be measured, NULL for parsing
+ * @param[in]  cfg           True if analyses run on the control flow graph
+ * @param[in]  repetitions   Number of repetitions
+ * @retval     bool          True if the phase completed
+ */
+static bool measure(const string &source, unsigned int statements,
+                    const Phase *phase, bool cfg, unsigned int repetitions)
+{
+  chrono::steady_clock::time_point start;
+  double seconds, best = 0.0;
+  struct rusage usage;
+  AST *program = NULL;
+  CFG *graph = NULL;
+  unsigned int i;
+  int status;
+  pid_t child;
+
+  cout.flush();
+  child = fork();
+  if(child < 0){ return false; }
+  if(child > 0){
+    waitpid(child, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+  }
+
+  // Parsing is measured as a whole, each other phase on its own.
+  for(i = 0; i < repetitions; ++i){
+    if(NULL == phase){
+      delete program;
+      start   = chrono::steady_clock::now();
+      program = prepare(source);
+    }
+    else{
+      if(NULL == program){
+        program = prepare(source);
+        graph   = (cfg && NULL != program) ? new CFG(program) : NULL;
+      }
+      if(NULL == program){ break; }
+      start = chrono::steady_clock::now();
+      phase->run(program, graph);
+    }
+
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start)
+              .count();
+    if(i == 0 || seconds < best){ best = seconds; }
+  }
+  if(NULL == program){ exit(EXIT_FAILURE); }
+
+  getrusage(RUSAGE_SELF, &usage);
+  cout << statements << ',' << source.size() << ','
+       << (phase ? phase->phase : "parse") << ','
+       << (phase ? phase->domain : "") << ',' << best << ','
+       << (best > 0.0 ? statements / best : 0.0) << ','
+       << usage.ru_maxrss << endl;
+  exit(EXIT_SUCCESS);
+}
+
+
+/** Main function.
+ * Program of each size is generated, then every phase is measured on it.
+ * @param[in]  argc        Number of arguments
+ * @param[in]  argv        Array of arguments
+ * @retval     int         Exit status
+ */
+int main(int argc, char *argv[])
+{
+  Generator::Parameters parameters = Generator::defaults;
+  vector<Analysis> available = registry(Domains()), analyses;
+  vector<Phase> phases;
+  vector<unsigned int> sizes = {1000, 10000, 100000};
+  vector<string> selected;
+  string unknown;
+  unsigned int repetitions = 3;
+  bool cfg = false, concrete = true, failed = false;
+  unsigned int i, j;
+  int a;
+
+  // Options.
+  for(a = 1; a < argc; ++a){
+    if(Generator::option(argc, argv, a, parameters)){ continue; }
+
+    // Sizes are given.
+    if((strcmp("--sizes", argv[a]) == 0 || strcmp("-z", argv[a]) == 0)
+       && (a+1 < argc)){
+      istringstream values(argv[++a]);
+      string value;
+
+      sizes.clear();
+      while(getline(values, value, ',')){
+        sizes.push_back(strtoul(value.c_str(), NULL, 10));
+      }
+    }
+
+    // Domains are selected.
+    else if((strcmp("--domain", argv[a]) == 0 || strcmp("-d", argv[a]) == 0)
+            && (a+1 < argc)){
+      istringstream keys(argv[++a]);
+      string key;
+
+      while(getline(keys, key, ',')){
+        selected.push_back(key);
+      }
+    }
+
+    // Repetitions are given.
+    else if((strcmp("--repeat", argv[a]) == 0 || strcmp("-n", argv[a]) == 0)
+            && (a+1 < argc)){
+      repetitions = strtoul(argv[++a], NULL, 10);
+      if(repetitions < 1){ repetitions = 1; }
+    }
+
+    // Control flow graph engine is requested.
+    else if(strcmp("--cfg", argv[a]) == 0 || strcmp("-c", argv[a]) == 0){
+      cfg = true;
+    }
+
+    // Concrete executions are skipped.
+    else if(strcmp("--abstract", argv[a]) == 0
+            || strcmp("-a", argv[a]) == 0){
+      concrete = false;
+    }
+
+    // Helper.
+    else{
+      bool help = strcmp("--help", argv[a]) == 0
+                  || strcmp("-h", argv[a]) == 0;
+
+      if(!help){
+        cerr << "[Scaling]: Unknown option '" << argv[a] << "'." << endl;
+      }
+      cout
+      << "Scaling benchmark of the While interpreter\n"
+      << "----------------------------------\n"
+      << "Usage: scaling [options]\n\n"
+      << "List of options:\n"
+      << "  -z, --sizes LIST Measure programs of the comma separated numbers\n"
+      << "                   of statements in LIST (default 1000,10000,100000)\n"
+      << "  -d, --domain LIST\n"
+      << "                   Analyze only over the comma separated domains\n"
+      << "                   in LIST: " << keys(available, 28) << "\n"
+      << "                   (default: every standard one)\n"
+      << "  -c, --cfg        Analyze the control flow graph with a worklist\n"
+      << "  -a, --abstract   Skip the concrete executions\n"
+      << "  -n, --repeat N   Keep the best of N runs of each phase (default 3)\n"
+      << Generator::help()
+      << "  -h, --help       Print this help and exit\n";
+      return help ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  // Selected domains are picked, standard ones if none is.
+  if(!select(available, selected, analyses, unknown)){
+    cerr << "[Scaling]: Unknown domain '" << unknown << "'." << endl;
+    return EXIT_FAILURE;
+  }
+  if(concrete){
+    phases.push_back({"execute", "", execute});
+    phases.push_back({"bytecode", "", run});
+  }
+  for(i = 0; i < analyses.size(); ++i){
+    phases.push_back({"analyze", analyses[i].key, analyses[i].run});
+  }
+
+  // Every phase is measured on every size.
+  cout << "statements,bytes,phase,domain,seconds,throughput,peak_kib" << endl;
+  for(i = 0; i < sizes.size(); ++i){
+    string source;
+
+    parameters.statements = sizes[i];
+    source = Generator(parameters).generate();
+
+    if(!measure(source, sizes[i], NULL, cfg, repetitions)){
+      cerr << "[Scaling]: Parsing failed on " << sizes[i] << " statements."
+           << endl;
+      failed = true;
+      continue;
+    }
+    for(j = 0; j < phases.size(); ++j){
+      if(!measure(source, sizes[i], &phases[j], cfg, repetitions)){
+        cerr << "[Scaling]: Phase " << phases[j].phase << " "
+             << phases[j].domain << " failed on " << sizes[i]
+             << " statements." << endl;
+        failed = true;
+      }
+    }
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/** Microbenchmark of the Sign domain.
+ * Program measuring the cost of the transfer functions of the Sign
+ * domain, both one value at a time and through the batch API.
+ *
+ * Usage: sign [N], where N is the number of values (default 1000000).
+ *
+ * @file sign.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#include <stdlib.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "../domains/Sign.hpp"
+
+using namespace std;
+
+
+/** Time elapsed since the given instant, in nanoseconds.
+ * @param[in]  start       Starting instant
+ * @retval     double      Elapsed nanoseconds
+ */
+static double elapsed(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double, nano>(chrono::steady_clock::now() - start)
+         .count();
+}
+
+
+/** Main function.
+ * Every binary transfer function is applied to N pairs of random values,
+ * first by the operators and then by Sign::apply(), and the average
+ * cost of an operation is printed.
+ * @param[in]  argc        Number of arguments
+ * @param[in]  argv        Array of arguments
+ * @retval     int         Exit status
+ */
+int main(int argc, char *argv[])
+{
+  const struct{
+    const char         *label;
+    Sign::operationType operation;
+  } operations[] = {
+    {"+  ", Sign::SUM}, {"-  ", Sign::SUB}, {"*  ", Sign::MUL},
+    {"/  ", Sign::DIV}, {"%  ", Sign::REM}, {"^  ", Sign::POW},
+    {"lub", Sign::LUB}
+  };
+  size_t n = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1000000;
+  vector<Sign> a(n), b(n), result(n);
+  chrono::steady_clock::time_point start;
+  double scalar, batch;
+  size_t i, checksum = 0;
+
+  // Operands are random signs, with some top values.
+  srand(42);
+  for(i = 0; i < n; ++i){
+    a[i] = (rand() % 8 == 0) ? Sign::top() : Sign::alpha(rand() % 3 - 1);
+    b[i] = (rand() % 8 == 0) ? Sign::top() : Sign::alpha(rand() % 3 - 1);
+  }
+
+  cout << "Operation  Scalar (ns/op)  Batch (ns/op)" << endl;
+  for(const auto &op : operations){
+    start = chrono::steady_clock::now();
+    for(i = 0; i < n; ++i){
+      switch(op.operation){
+        case Sign::SUM: result[i] = a[i] + b[i];          break;
+        case Sign::SUB: result[i] = a[i] - b[i];          break;
+        case Sign::MUL: result[i] = a[i] * b[i];          break;
+        case Sign::DIV: result[i] = a[i] / b[i];          break;
+        case Sign::REM: result[i] = a[i] % b[i];          break;
+        case Sign::POW: result[i] = a[i] ^ b[i];          break;
+        case Sign::LUB: result[i] = Sign::lub(a[i], b[i]); break;
+      }
+    }
+    scalar = elapsed(start) / n;
+    for(i = 0; i < n; ++i){ checksum += Sign::hash(result[i]); }
+
+    start = chrono::steady_clock::now();
+    Sign::apply(op.operation, a.data(), b.data(), result.data(), n);
+    batch = elapsed(start) / n;
+    for(i = 0; i < n; ++i){ checksum += Sign::hash(result[i]); }
+
+    cout << op.label << "        " << scalar << "\t\t" << batch << endl;
+  }
+
+  // Checksum keeps results alive.
+  cout << "Checksum: " << checksum << endl;
+
+  return EXIT_SUCCESS;
+}
@@ -8,10 +8,88 @@
 #ifndef DOMAINS_HPP
 #define DOMAINS_HPP
 
+#include "domains/Thresholds.hpp"
 #include "domains/BlackHole.hpp"
 #include "domains/Sign.hpp"
 #include "domains/Interval.hpp"
 #include "domains/SInterval.hpp"
 #include "domains/Modulo.hpp"
+#include "domains/PModulo.hpp"
+#include "domains/Congruence.hpp"
+#include "domains/Product.hpp"
+#include "domains/Zone.hpp"
+#include "domains/Octagon.hpp"
+
+
+/** Reduced product of every non-relational domain. */
+typedef Product< Sign, Interval, SInterval, Congruence > Full;
+
+
+
+/** Compile-time list of abstract domains.
+ * @tparam     Ds          Abstract domains in the list
+ */
+template <typename... Ds>
+struct DomainList{};
+
+
+
+/** Traits describing how a domain is selected and reported.
+ * Every domain in Domains shall specialize this template, providing:
+ * key, the name used to select the domain from the command line; name,
+ * the one printed along with results and statistics; standard, true
+ * if the domain is analyzed when none is selected.
+ * @tparam     D           Abstract domain
+ */
+template <typename D>
+struct DomainTraits;
+
+template <> struct DomainTraits<Sign>{
+  static constexpr const char *key = "sign", *name = "Sign";
+  static constexpr bool standard = true;
+};
+
+template <> struct DomainTraits<Interval>{
+  static constexpr const char *key = "interval", *name = "Interval";
+  static constexpr bool standard = true;
+};
+
+template <> struct DomainTraits<SInterval>{
+  static constexpr const char *key = "sinterval", *name = "S-Interval";
+  static constexpr bool standard = true;
+};
+
+template <> struct DomainTraits<Congruence>{
+  static constexpr const char *key = "congruence", *name = "Congruence";
+  static constexpr bool standard = true;
+};
+
+template <> struct DomainTraits< PModulo<4> >{
+  static constexpr const char *key = "pmodulo4", *name = "P-Modulo 4";
+  static constexpr bool standard = false;
+};
+
+template <> struct DomainTraits<Zone>{
+  static constexpr const char *key = "zone", *name = "Zone";
+  static constexpr bool standard = false;
+};
+
+template <> struct DomainTraits<Octagon>{
+  static constexpr const char *key = "octagon", *name = "Octagon";
+  static constexpr bool standard = false;
+};
+
+template <> struct DomainTraits<Full>{
+  static constexpr const char *key = "product", *name = "Product";
+  static constexpr bool standard = false;
+};
+
+
+/** Every domain which can be analyzed, in the order results are printed.
+ * A new domain is made available by adding it here, along with its
+ * DomainTraits.
+ */
+typedef DomainList< Sign, Interval, SInterval, Congruence, PModulo<4>,
+                    Zone, Octagon, Full > Domains;
 
 #endif
@@ -194,6 +194,18 @@ bool BlackHole::equal(BlackHole a, BlackHole b)
 }
 
 
+/** Hash function.
+ * Values which are equal, according to equal(), have the same hash.
+ * @param[in]  a           Abstract value
+ * @retval     size_t      Hash of the value
+ */
+size_t BlackHole::hash(BlackHole a)
+{
+  (void) a;
+  return 0;
+}
+
+
 /** Least upperbound between two values in the abstract domain is
  * computed.
  * @param[in]  a           First abstract value
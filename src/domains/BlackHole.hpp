@@ -144,6 +144,14 @@ class BlackHole
   static bool equal(BlackHole a, BlackHole b);
   
   
+  /** Hash function.
+   * Values which are equal, according to equal(), have the same hash.
+   * @param[in]  a           Abstract value
+   * @retval     size_t      Hash of the value
+   */
+  static size_t hash(BlackHole a);
+  
+  
   /** Least upperbound between two values in the abstract domain is
    * computed.
    * @param[in]  a           First abstract value
@@ -0,0 +1,508 @@
+/** Congruence abstract interpretation.
+ * Class handling the abstract interpretation in the Congruence abstract
+ * domain.
+ *
+ * @file Congruence.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ * @ingroup domains
+ */
+#include <stdio.h>
+#include <limits>
+
+#include "Congruence.hpp"
+
+
+/** 'Less than' operator overloading.
+ * @param[in]  other       Right-operand
+ * @retval     bool        False if left-operand is for sure not
+ *                         smaller than the second one
+ */
+bool Congruence::operator< (Congruence other)
+{
+  if(bottom || other.bottom){ return false; }
+  if(constant() && other.constant()){ return remainder < other.remainder; }
+  return true;
+}
+
+
+/** 'Less than or equal to' operator overloading.
+ * @param[in]  other       Right-operand
+ * @retval     bool        False if left-operand is for sure not
+ *                         smaller than or equal to the second one
+ */
+bool Congruence::operator<=(Congruence other)
+{
+  if(bottom || other.bottom){ return false; }
+  if(constant() && other.constant()){ return remainder <= other.remainder; }
+  return true;
+}
+
+
+/** 'Equal to' operator overloading.
+ * Values may be equal if and only if their remainders are congruent
+ * modulo the gcd of the moduli.
+ * @param[in]  other       Right-operand
+ * @retval     bool        False if left-operand is for sure not equal
+ *                         to the second one
+ */
+bool Congruence::operator==(Congruence other)
+{
+  long g;
+
+  if(bottom || other.bottom){ return false; }
+  if(!gcd(modulus, other.modulus, g)){ return true; }
+  if(g == 0){ return remainder == other.remainder; }
+  return make(g, remainder).remainder == make(g, other.remainder).remainder;
+}
+
+
+/** 'Greater than or equal to' operator overloading.
+ * @param[in]  other       Right-operand
+ * @retval     bool        False if left-operand is for sure greater
+ *                         than or equal to the second one
+ */
+bool Congruence::operator>=(Congruence other)
+{
+  if(bottom || other.bottom){ return false; }
+  if(constant() && other.constant()){ return remainder >= other.remainder; }
+  return true;
+}
+
+
+/** 'Greater' operator overloading.
+ * @param[in]  other       Right-operand
+ * @retval     bool        False if left-operand is for sure greater
+ *                         than the second one
+ */
+bool Congruence::operator> (Congruence other)
+{
+  if(bottom || other.bottom){ return false; }
+  if(constant() && other.constant()){ return remainder > other.remainder; }
+  return true;
+}
+
+
+/** 'Not equal to' operator overloading.
+ * @param[in]  other       Right-operand
+ * @retval     bool        False if left-operand is for sure not equal
+ *                         to the second one
+ */
+bool Congruence::operator!=(Congruence other)
+{
+  if(bottom || other.bottom){ return false; }
+  if(constant() && other.constant()){ return remainder != other.remainder; }
+  return true;
+}
+
+
+/** Identity operator overloading.
+ * @retval     Congruence  Identity of the value
+ */
+Congruence Congruence::operator+()
+{
+  return *this;
+}
+
+
+/** Opposite operator overloading.
+ * @retval     Congruence  Opposite of the value
+ */
+Congruence Congruence::operator-()
+{
+  if(bottom){ return bot(); }
+  if(remainder == numeric_limits<long>::min()){ return top(); }
+  return make(modulus, -remainder);
+}
+
+
+/** Sum operator overloading.
+ * @param[in]  other       Right-operand
+ * @retval     Congruence  Sum of the current and the given values
+ */
+Congruence Congruence::operator+(Congruence other)
+{
+  long g, a, b, sum;
+
+  if(bottom || other.bottom){ return bot(); }
+  if(!gcd(modulus, other.modulus, g)){ return top(); }
+
+  a = (g == 0) ? remainder       : make(g, remainder).remainder;
+  b = (g == 0) ? other.remainder : make(g, other.remainder).remainder;
+  if(__builtin_add_overflow(a, b, &sum)){ return top(); }
+
+  return make(g, sum);
+}
+
+
+/** Subtraction operator overloading.
+ * @param[in]  other       Right-operand
+ * @retval     Congruence  Difference between the current and the
+ *                         given values
+ */
+Congruence Congruence::operator-(Congruence other)
+{
+  return *this + (-other);
+}
+
+
+/** Multiplication operator overloading.
+ * (aZ + b)(cZ + d) is included in gcd(ac, ad, bc)Z + bd.
+ * @param[in]  other       Right-operand
+ * @retval     Congruence  Product of the current and the given values
+ */
+Congruence Congruence::operator*(Congruence other)
+{
+  long ac, ad, bc, bd, g;
+
+  if(bottom || other.bottom){ return bot(); }
+  if(__builtin_mul_overflow(modulus,   other.modulus,   &ac)
+  || __builtin_mul_overflow(modulus,   other.remainder, &ad)
+  || __builtin_mul_overflow(remainder, other.modulus,   &bc)
+  || __builtin_mul_overflow(remainder, other.remainder, &bd)
+  || !gcd(ac, ad, g) || !gcd(g, bc, g)){
+    return top();
+  }
+
+  return make(g, bd);
+}
+
+
+/** Integer division operator overloading.
+ * Division is exact only by a constant which divides both the modulus
+ * and the remainder: any other case gives top.
+ * @param[in]  other       Right-operand
+ * @retval     Congruence  Integer division between the current and
+ *                         the given values
+ */
+Congruence Congruence::operator/(Congruence other)
+{
+  long c = other.remainder;
+
+  if(bottom || other.bottom){ return bot(); }
+  if(!other.constant()){ return top(); }
+  if(c == 0){ return bot(); }
+
+  if(constant()){
+    if(c == -1 && remainder == numeric_limits<long>::min()){ return top(); }
+    return make(0, remainder / c);
+  }
+  if(modulus % c != 0 || remainder % c != 0){ return top(); }
+
+  return make(modulus / c, remainder / c);
+}
+
+
+/** Remainder of the integer division operator overloading.
+ * Divisor is a multiple of the gcd of its modulus and remainder, hence
+ * the remainder is congruent to the dividend modulo the gcd of it and
+ * the modulus of the dividend.
+ * @param[in]  other       Right-operand
+ * @retval     Congruence  Remainder of the integer division between
+ *                         the current and the given value
+ */
+Congruence Congruence::operator%(Congruence other)
+{
+  long g;
+
+  if(bottom || other.bottom){ return bot(); }
+  if(other.constant() && other.remainder == 0){ return bot(); }
+
+  if(constant() && other.constant()){
+    if(other.remainder == -1){ return make(0, 0); }
+    return make(0, remainder % other.remainder);
+  }
+  if(!gcd(other.modulus, other.remainder, g) || !gcd(modulus, g, g)){
+    return top();
+  }
+
+  return make(g, remainder);
+}
+
+
+/** Power raising operator overloading.
+ * Non-positive exponents give 1, as in the concrete semantics. With a
+ * constant exponent, powers are computed modulo the modulus of the base.
+ * @param[in]  other       Right-operand
+ * @retval     Congruence  Current value raised to the power of the
+ *                         given one
+ */
+Congruence Congruence::operator^(Congruence other)
+{
+  long e, base, pow = 1;
+
+  if(bottom || other.bottom){ return bot(); }
+  if(constant() && remainder == 1){ return make(0, 1); }
+  if(!other.constant()){ return top(); }
+  if(other.remainder <= 0){ return make(0, 1); }
+
+  base = remainder;
+  for(e = other.remainder; e > 0; e >>= 1){
+    if(e & 1){
+      if(__builtin_mul_overflow(pow, base, &pow)){ return top(); }
+      if(!constant()){ pow %= modulus; }
+    }
+    if(e > 1){
+      if(__builtin_mul_overflow(base, base, &base)){ return top(); }
+      if(!constant()){ base %= modulus; }
+    }
+  }
+
+  return make(modulus, pow);
+}
+
+
+/** Cast to const char * operator overloading.
+ * This method is used to provide a textual representation of the
+ * value: bot, top, a constant or aZ+b.
+ * @retval     const char * Textual representation of the value
+ */
+Congruence::operator const char * ()
+{
+  static thread_local char text[48];
+
+  if(bottom){ return "bot"; }
+  if(modulus == 1){ return "top"; }
+
+  if(constant()){ sprintf(text, "%ld", remainder); }
+  else{ sprintf(text, "%ldZ+%ld", modulus, remainder); }
+
+  return text;
+}
+
+
+/** Predicate testing whether two values are equal.
+ * @param[in]  a           First operand
+ * @param[in]  b           Second operand
+ * @retval     bool        True if and only if values are precisely
+ *                         equal
+ */
+bool Congruence::equal(Congruence a, Congruence b)
+{
+  if(a.bottom || b.bottom){ return a.bottom == b.bottom; }
+  return a.modulus == b.modulus && a.remainder == b.remainder;
+}
+
+
+/** Hash function.
+ * Values which are equal, according to equal(), have the same hash.
+ * @param[in]  a           Abstract value
+ * @retval     size_t      Hash of the value
+ */
+size_t Congruence::hash(Congruence a)
+{
+  if(a.bottom){ return 0; }
+  return (size_t) a.modulus * 31 + (size_t) a.remainder;
+}
+
+
+/** Least upperbound between two values in the abstract domain is
+ * computed.
+ * aZ + b and cZ + d are both included in gcd(a, c, |b - d|)Z + b.
+ * @param[in]  a           First abstract value
+ * @param[in]  b           Second abstract value
+ * @retval     Congruence  Least upperbound of a and b
+ */
+Congruence Congruence::lub(Congruence a, Congruence b)
+{
+  long g, difference;
+
+  if(a.bottom){ return b; }
+  if(b.bottom){ return a; }
+  if(__builtin_sub_overflow(a.remainder, b.remainder, &difference)
+  || !gcd(a.modulus, b.modulus, g) || !gcd(g, difference, g)){
+    return top();
+  }
+
+  return make(g, a.remainder);
+}
+
+
+/** Widening operator.
+ * Constant may grow into a congruence once, then any further change of
+ * the modulus gives top. Chains are thus at most three steps long, even
+ * when a reduced product keeps narrowing the current value.
+ * @param[in]  a           Previous value
+ * @param[in]  b           Current value
+ * @retval     Congruence  Widened value
+ */
+Congruence Congruence::nabla(Congruence a, Congruence b)
+{
+  Congruence joined = lub(a, b);
+
+  if(a.bottom || a.constant() || equal(joined, a)){ return joined; }
+  return top();
+}
+
+
+/** Abstraction function.
+ * For the particular case when given set is a singleton.
+ * @param[in]  value       Value of the concrete domain
+ * @retval     Congruence  Abstract value corresponding to the
+ *                         given concrete value
+ */
+Congruence Congruence::alpha(int value)
+{
+  return make(0, value);
+}
+
+
+/** Abstraction function.
+ * @param[in]  values      Subset of the concrete domain
+ * @retval     Congruence  Abstract value corresponding to the least
+ *                         upperbound of the concrete values
+ */
+Congruence Congruence::alpha(vector<int> values)
+{
+  Congruence result = bot();
+  unsigned int i;
+
+  for(i = 0; i < values.size(); ++i){
+    result = lub(result, alpha(values[i]));
+  }
+
+  return result;
+}
+
+
+/** Constant method returning an instance of the "I don't know" value.
+ * @retval     Congruence  Value representing no information
+ */
+Congruence Congruence::top()
+{
+  return make(1, 0);
+}
+
+
+/** Bounds of the concrete values are provided.
+ * This method is used by reduced products to exchange information
+ * between domains. Only constants are bounded, bottom is represented
+ * by an empty range.
+ * @param[out] lower       Lower bound of the concrete values
+ * @param[out] upper       Upper bound of the concrete values
+ */
+void Congruence::bounds(long &lower, long &upper)
+{
+  if(bottom){
+    lower = 1;
+    upper = 0;
+  }
+  else if(constant()){
+    lower = remainder;
+    upper = remainder;
+  }
+  else{
+    lower = numeric_limits<long>::min();
+    upper = numeric_limits<long>::max();
+  }
+}
+
+
+/** Value is refined by the given bounds.
+ * This method is used by reduced products to exchange information
+ * between domains. Value becomes bottom if no congruent value is in
+ * the range, and a constant if only one is.
+ * @param[in]  lower       Lower bound of the concrete values
+ * @param[in]  upper       Upper bound of the concrete values
+ */
+void Congruence::meet(long lower, long upper)
+{
+  long first, gap;
+
+  if(bottom){ return; }
+  if(lower > upper){
+    bottom = true;
+    return;
+  }
+
+  if(constant()){
+    if((lower != numeric_limits<long>::min() && remainder < lower)
+    || (upper != numeric_limits<long>::max() && remainder > upper)){
+      bottom = true;
+    }
+    return;
+  }
+  if(lower == numeric_limits<long>::min()
+  || upper == numeric_limits<long>::max()){
+    return;
+  }
+
+  gap = remainder - make(modulus, lower).remainder;
+  if(gap < 0){ gap += modulus; }
+  if(__builtin_add_overflow(lower, gap, &first)){ return; }
+
+  if(first > upper){ bottom = true; }
+  else if(__builtin_sub_overflow(upper, first, &gap) || gap < modulus){
+    *this = make(0, first);
+  }
+}
+
+
+/** Value aZ + b is built and normalized.
+ * Modulus is made positive and remainder is reduced modulo it.
+ * @param[in]  a           Modulus
+ * @param[in]  b           Remainder
+ * @retval     Congruence  Value aZ + b
+ */
+Congruence Congruence::make(long a, long b)
+{
+  Congruence result;
+
+  if(a == numeric_limits<long>::min()){ a = 1; }
+  result.bottom    = false;
+  result.modulus   = (a < 0) ? -a : a;
+  result.remainder = b;
+  if(result.modulus > 0){
+    result.remainder %= result.modulus;
+    if(result.remainder < 0){ result.remainder += result.modulus; }
+  }
+
+  return result;
+}
+
+
+/** Constant method returning an instance of the bottom value.
+ * @retval     Congruence  Value representing no concrete value
+ */
+Congruence Congruence::bot()
+{
+  Congruence result = make(1, 0);
+
+  result.bottom = true;
+  return result;
+}
+
+
+/** Predicate testing whether the value is a constant.
+ * @retval     bool        True if the value is a single number
+ */
+bool Congruence::constant() const
+{
+  return modulus == 0;
+}
+
+
+/** Greatest common divisor of two numbers.
+ * gcd(a, 0) is |a|, so that constants are neutral.
+ * @param[in]  a           First number
+ * @param[in]  b           Second number
+ * @param[out] g           Greatest common divisor
+ * @retval     bool        False if the result overflows a long
+ */
+bool Congruence::gcd(long a, long b, long &g)
+{
+  long t;
+
+  if(a == numeric_limits<long>::min() || b == numeric_limits<long>::min()){
+    return false;
+  }
+  a = (a < 0) ? -a : a;
+  b = (b < 0) ? -b : b;
+  while(b != 0){
+    t = a % b;
+    a = b;
+    b = t;
+  }
+  g = a;
+
+  return true;
+}
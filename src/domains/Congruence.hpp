@@ -0,0 +1,258 @@
+/** Congruence abstract interpretation.
+ * Class handling the abstract interpretation in the Congruence abstract
+ * domain.
+ *
+ * @file Congruence.hpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ * @ingroup domains
+ */
+#ifndef _CONGRUENCE_HPP_
+#define _CONGRUENCE_HPP_
+
+#include <stddef.h>
+#include <vector>
+
+using namespace std;
+
+/** Class representing the congruence domain abstraction.
+ * In the congruence domain, every value is identified by a set aZ + b,
+ * that is by the values which are congruent to b modulo a: modulus 0
+ * stands for the constant b, modulus 1 for top. Unlike Modulo<N>, the
+ * modulus is not fixed, so that a single analysis tracks parity,
+ * strides and constants at once. Remainder is always in [0, a) for a
+ * positive modulus. Operations whose result overflows a long give top.
+ */
+class Congruence
+{
+  public:
+  /** 'Less than' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not
+   *                         smaller than the second one
+   */
+  bool operator< (Congruence other);
+
+
+  /** 'Less than or equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not
+   *                         smaller than or equal to the second one
+   */
+  bool operator<=(Congruence other);
+
+
+  /** 'Equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not equal
+   *                         to the second one
+   */
+  bool operator==(Congruence other);
+
+
+  /** 'Greater than or equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure greater
+   *                         than or equal to the second one
+   */
+  bool operator>=(Congruence other);
+
+
+  /** 'Greater' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure greater
+   *                         than the second one
+   */
+  bool operator> (Congruence other);
+
+
+  /** 'Not equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not equal
+   *                         to the second one
+   */
+  bool operator!=(Congruence other);
+
+
+  /** Identity operator overloading.
+   * @retval     Congruence  Identity of the value
+   */
+  Congruence operator+();
+
+
+  /** Opposite operator overloading.
+   * @retval     Congruence  Opposite of the value
+   */
+  Congruence operator-();
+
+
+  /** Sum operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Congruence  Sum of the current and the given values
+   */
+  Congruence operator+(Congruence other);
+
+
+  /** Subtraction operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Congruence  Difference between the current and the
+   *                         given values
+   */
+  Congruence operator-(Congruence other);
+
+
+  /** Multiplication operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Congruence  Product of the current and the given values
+   */
+  Congruence operator*(Congruence other);
+
+
+  /** Integer division operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Congruence  Integer division between the current and
+   *                         the given values
+   */
+  Congruence operator/(Congruence other);
+
+
+  /** Remainder of the integer division operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Congruence  Remainder of the integer division between
+   *                         the current and the given value
+   */
+  Congruence operator%(Congruence other);
+
+
+  /** Power raising operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Congruence  Current value raised to the power of the
+   *                         given one
+   */
+  Congruence operator^(Congruence other);
+
+
+  /** Cast to const char * operator overloading.
+   * This method is used to provide a textual representation of the
+   * value: bot, top, a constant or aZ+b.
+   * @retval     const char * Textual representation of the value
+   */
+  operator const char * ();
+
+
+  /** Predicate testing whether two values are equal.
+   * @param[in]  a           First operand
+   * @param[in]  b           Second operand
+   * @retval     bool        True if and only if values are precisely
+   *                         equal
+   */
+  static bool equal(Congruence a, Congruence b);
+
+
+  /** Hash function.
+   * Values which are equal, according to equal(), have the same hash.
+   * @param[in]  a           Abstract value
+   * @retval     size_t      Hash of the value
+   */
+  static size_t hash(Congruence a);
+
+
+  /** Least upperbound between two values in the abstract domain is
+   * computed.
+   * @param[in]  a           First abstract value
+   * @param[in]  b           Second abstract value
+   * @retval     Congruence  Least upperbound of a and b
+   */
+  static Congruence lub(Congruence a, Congruence b);
+
+
+  /** Widening operator.
+   * Constant may grow into a congruence once, then any further change of
+   * the modulus gives top. Chains are thus at most three steps long,
+   * even when a reduced product keeps narrowing the current value.
+   * @param[in]  a           Previous value
+   * @param[in]  b           Current value
+   * @retval     Congruence  Widened value
+   */
+  static Congruence nabla(Congruence a, Congruence b);
+
+
+  /** Abstraction function.
+   * For the particular case when given set is a singleton.
+   * @param[in]  value       Value of the concrete domain
+   * @retval     Congruence  Abstract value corresponding to the
+   *                         given concrete value
+   */
+  static Congruence alpha(int value);
+
+
+  /** Abstraction function.
+   * @param[in]  values      Subset of the concrete domain
+   * @retval     Congruence  Abstract value corresponding to the least
+   *                         upperbound of the concrete values
+   */
+  static Congruence alpha(vector<int> values);
+
+
+  /** Constant method returning an instance of the "I don't know" value.
+   * @retval     Congruence  Value representing no information
+   */
+  static Congruence top();
+
+
+  /** Bounds of the concrete values are provided.
+   * This method is used by reduced products to exchange information
+   * between domains. Only constants are bounded, bottom is represented
+   * by an empty range.
+   * @param[out] lower       Lower bound of the concrete values
+   * @param[out] upper       Upper bound of the concrete values
+   */
+  void bounds(long &lower, long &upper);
+
+
+  /** Value is refined by the given bounds.
+   * This method is used by reduced products to exchange information
+   * between domains. Value becomes bottom if no congruent value is in
+   * the range, and a constant if only one is.
+   * @param[in]  lower       Lower bound of the concrete values
+   * @param[in]  upper       Upper bound of the concrete values
+   */
+  void meet(long lower, long upper);
+
+
+  private:
+  bool bottom;          ///< True if the value is bottom
+  long modulus;         ///< Modulus, 0 for a constant
+  long remainder;       ///< Remainder, in [0, modulus) if modulus > 0
+
+
+  /** Value aZ + b is built and normalized.
+   * Modulus is made positive and remainder is reduced modulo it.
+   * @param[in]  a           Modulus
+   * @param[in]  b           Remainder
+   * @retval     Congruence  Value aZ + b
+   */
+  static Congruence make(long a, long b);
+
+
+  /** Constant method returning an instance of the bottom value.
+   * @retval     Congruence  Value representing no concrete value
+   */
+  static Congruence bot();
+
+
+  /** Predicate testing whether the value is a constant.
+   * @retval     bool        True if the value is a single number
+   */
+  bool constant() const;
+
+
+  /** Greatest common divisor of two numbers.
+   * gcd(a, 0) is |a|, so that constants are neutral.
+   * @param[in]  a           First number
+   * @param[in]  b           Second number
+   * @param[out] g           Greatest common divisor
+   * @retval     bool        False if the result overflows a long
+   */
+  static bool gcd(long a, long b, long &g);
+};
+#endif
@@ -7,10 +7,12 @@
  * @ingroup domains
  */
 #include <malloc.h>
+#include <algorithm>
 #include <iostream>
 #include <limits>
 
 #include "Interval.hpp"
+#include "Thresholds.hpp"
 
 
 /** 'Less than' operator overloading.
@@ -96,9 +98,10 @@ Interval Interval::operator-()
 {
   Interval opp;
   
-  opp.lBound = -rBound;
-  opp.rBound = -lBound;
+  opp.lBound = neg(rBound);
+  opp.rBound = neg(lBound);
   opp.bottom = bottom;
+  opp.clamp();
   
   return opp;
 }
@@ -112,9 +115,10 @@ Interval Interval::operator+(Interval other)
 {
   Interval sum;
   
-  sum.lBound = lBound + other.lBound;
-  sum.rBound = rBound + other.rBound;
+  sum.lBound = add(lBound, other.lBound);
+  sum.rBound = add(rBound, other.rBound);
   sum.bottom = bottom || other.bottom ;
+  sum.clamp();
   
   return sum;
 }
@@ -129,68 +133,81 @@ Interval Interval::operator-(Interval other)
 {
   Interval sub;
   
-  sub.lBound = lBound - other.rBound;
-  sub.rBound = rBound - other.lBound;
+  sub.lBound = add(lBound, neg(other.rBound));
+  sub.rBound = add(rBound, neg(other.lBound));
   sub.bottom = bottom || other.bottom;
+  sub.clamp();
   
   return sub;
 }
 
 
 /** Multiplication operator overloading.
+ * Product ranges between the smallest and the greatest product of the
+ * bounds.
  * @param[in]  other       Right-operand
  * @retval     Interval    Product of the current and the given values
  */
 Interval Interval::operator*(Interval other)
 {
-  long tmp;
   Interval mul;
+  long corners[4] = {
+    product(lBound, other.lBound), product(lBound, other.rBound),
+    product(rBound, other.lBound), product(rBound, other.rBound)
+  };
   
-  mul.lBound = lBound * other.lBound;
-  mul.rBound = rBound * other.rBound;
   mul.bottom = bottom || other.bottom;
-  if(mul.lBound > mul.rBound){
-    tmp = mul.lBound;
-    mul.lBound = mul.rBound;
-    mul.rBound = tmp;
-  }
+  mul.lBound = *min_element(corners, corners + 4);
+  mul.rBound = *max_element(corners, corners + 4);
+  mul.clamp();
   
   return mul;
 }
 
 
 /** Integer division operator overloading.
+ * Divisor is split into its negative and positive parts, since zero
+ * never divides; quotient over each part ranges between the quotients
+ * of the bounds.
  * @param[in]  other       Right-operand
  * @retval     Interval    Integer division between the current and
  *                         the given values
  */
 Interval Interval::operator/(Interval other)
 {
-  long tmp;
   Interval div;
   
-  div.bottom = bottom || other.bottom;
-  if(other.rBound == 0 && other.lBound == 0){
-    div.bottom = true;
-    return div;
-  }
-  else if(other.rBound == 0 || other.lBound == 0){
-    return top();
+  // Quotient by a divisor which does not contain zero.
+  auto part = [this](long lower, long upper){
+    Interval q;
+    long corners[4] = {
+      quotient(lBound, lower), quotient(lBound, upper),
+      quotient(rBound, lower), quotient(rBound, upper)
+    };
+    
+    q.bottom = false;
+    q.lBound = *min_element(corners, corners + 4);
+    q.rBound = *max_element(corners, corners + 4);
+    return q;
+  };
+  
+  div.bottom = true;
+  if(bottom || other.bottom){ return div; }
+  if(other.lBound < 0){
+    div = lub(div, part(other.lBound, min(other.rBound, -1L)));
   }
-  
-  div.lBound = lBound / other.rBound;
-  div.rBound = rBound / other.lBound;
-  if(div.lBound > div.rBound){
-    tmp = div.lBound;
-    div.lBound = div.rBound;
-    div.rBound = tmp;
+  if(other.rBound > 0){
+    div = lub(div, part(max(other.lBound, 1L), other.rBound));
   }
+  div.clamp();
   
   return div;
 }
 
 
 /** Remainder of the integer division operator overloading.
+ * Remainder takes the sign of the dividend, and is smaller than both
+ * the dividend and the divisor in absolute value.
  * @param[in]  other       Right-operand
  * @retval     Interval    Remainder of the integer division between
  *                         the current and the given value
@@ -198,59 +215,50 @@ Interval Interval::operator/(Interval other)
 Interval Interval::operator%(Interval other)
 {
   Interval rem;
+  long m;
   
-  rem.bottom = bottom || other.bottom;
-  if(other.rBound == 0 && other.lBound == 0){
-    rem.bottom = true;
+  rem.bottom = true;
+  if(bottom || other.bottom || (other.lBound == 0 && other.rBound == 0)){
     return rem;
   }
-  else if(other.rBound == 0 || other.lBound == 0){
-    return top();
-  }
   
-  if(other.lBound > 0){
-    rem.lBound = 0L;
-    rem.rBound = other.rBound - 1L;
-  }
-  else if(other.rBound < 0){
-    rem.lBound = other.lBound + 1L;
-    rem.rBound = 0L;
-  }
-  else{
-    rem.lBound = other.lBound + 1L;
-    rem.rBound = other.rBound - 1L;
-  }
+  m = add(max(neg(other.lBound), other.rBound), -1L);
+  rem.bottom = false;
+  rem.lBound = (lBound >= 0) ? 0L : max(lBound, neg(m));
+  rem.rBound = (rBound <= 0) ? 0L : min(rBound, m);
   
   return rem;
 }
 
 
 /** Power raising operator overloading.
+ * Negative exponents give 1, as in the concrete semantics. Powers are
+ * joined exponent by exponent: from the 16th on they only depend on the
+ * parity of the exponent, hence 18 exponents at most are enough.
  * @param[in]  other       Right-operand
  * @retval     Interval    Current value raised to the power of the
  *                         given one
  */
 Interval Interval::operator^(Interval other)
 {
-  long i;
-  Interval pow;
-  
-  pow.bottom = bottom || other.bottom;
-  pow.lBound = 1L;
-  for(i = 0; i < other.lBound; ++i){
-    pow.lBound *= (long) lBound;
-  }
-  
-  pow.rBound = 1L;
-  for(i = 0; i < other.rBound; ++i){
-    pow.rBound *= (long) rBound;
-  }
-  
-  if(lBound > rBound){
-    i = lBound;
-    lBound = rBound;
-    rBound = i;
+  Interval pow, term;
+  long e, first, last;
+  
+  pow.bottom = true;
+  if(bottom || other.bottom){ return pow; }
+  
+  first = max(other.lBound, 0L);
+  last  = min(other.rBound, first + 17);
+  if(other.lBound <= 0){ pow = alpha(1); }
+  
+  for(e = max(first, 1L); e <= last; ++e){
+    term.bottom = false;
+    term.lBound = min(power(lBound, e), power(rBound, e));
+    term.rBound = max(power(lBound, e), power(rBound, e));
+    if(e % 2 == 0 && lBound < 0 && rBound > 0){ term.lBound = 0L; }
+    pow = lub(pow, term);
   }
+  pow.clamp();
   
   return pow;
 }
@@ -263,7 +271,8 @@ Interval Interval::operator^(Interval other)
  */
 Interval::operator const char * ()
 {
-  char left[16], right[16];
+  static thread_local char text[48];
+  char left[24], right[24];
   
   sprintf(left,  "%ld", lBound);
   sprintf(right, "%ld", rBound);
@@ -276,7 +285,9 @@ Interval::operator const char * ()
   + (rBound>=numeric_limits<short>::max() ? "+inf)" : (right + string("]")))
   ;
   
-  return a.c_str();
+  // Text is kept in a per-thread buffer, which outlives the call.
+  snprintf(text, sizeof(text), "%s", a.c_str());
+  return text;
 }
 
   
@@ -288,8 +299,24 @@ Interval::operator const char * ()
  */
 bool Interval::equal(Interval a, Interval b)
 {
-  return (a.lBound == b.lBound && a.rBound == b.rBound)
-      &&  a.bottom == b.bottom;
+  // Bounds of bottom are meaningless, so every bottom is the same.
+  if(a.bottom || b.bottom){ return a.bottom && b.bottom; }
+  return a.lBound == b.lBound && a.rBound == b.rBound;
+}
+
+
+/** Hash function.
+ * Values which are equal, according to equal(), have the same hash.
+ * @param[in]  a           Abstract value
+ * @retval     size_t      Hash of the value
+ */
+size_t Interval::hash(Interval a)
+{
+  size_t h = (size_t) a.lBound;
+  
+  if(a.bottom){ return 0; }
+  h ^= (size_t) a.rBound + 0x9E3779B9 + (h << 6) + (h >> 2);
+  return h;
 }
 
 
@@ -316,6 +343,10 @@ Interval Interval::lub(Interval a, Interval b)
 
 
 /** Widening operator.
+ * Bounds which grow are widened to the nearest threshold, see
+ * Thresholds, or to infinity if there is none. Bounds which do not grow
+ * are kept from the previous value, so that the result never shrinks
+ * even when the current value was narrowed by a reduction.
  * @param[in]  a           Previous value
  * @param[in]  b           Current value
  * @retval     Interval    Widened value
@@ -324,13 +355,16 @@ Interval Interval::nabla(Interval a, Interval b)
 {
   Interval widened;
   
+  if(a.bottom){ return b; }
+  if(b.bottom){ return a; }
+  
   widened.lBound = (b.lBound < a.lBound)
-                 ? numeric_limits<short>::min()
-                 : b.lBound;
+                 ? Thresholds::below(b.lBound)
+                 : a.lBound;
   widened.rBound = (b.rBound > a.rBound)
-                 ? numeric_limits<short>::max()
-                 : b.rBound;
-  widened.bottom = b.bottom;
+                 ? Thresholds::above(b.rBound)
+                 : a.rBound;
+  widened.bottom = false;
   
   return widened;
 }
@@ -386,3 +420,154 @@ Interval Interval::top()
   
   return top;
 }
+
+
+/** Bounds of the concrete values are provided.
+ * This method is used by reduced products to exchange information
+ * between domains. Missing bounds are represented by the limits of
+ * long, bottom is represented by an empty range.
+ * @param[out] lower       Lower bound of the concrete values
+ * @param[out] upper       Upper bound of the concrete values
+ */
+void Interval::bounds(long &lower, long &upper)
+{
+  if(bottom){
+    lower = 1L;
+    upper = 0L;
+    return;
+  }
+  
+  lower = (lBound <= numeric_limits<short>::min())
+        ? numeric_limits<long>::min() : lBound;
+  upper = (rBound >= numeric_limits<short>::max())
+        ? numeric_limits<long>::max() : rBound;
+}
+
+
+/** Value is refined by the given bounds.
+ * This method is used by reduced products to exchange information
+ * between domains. Value becomes bottom if the range is empty. Bounds
+ * beyond the limits of short become infinite, as they do everywhere.
+ * @param[in]  lower       Lower bound of the concrete values
+ * @param[in]  upper       Upper bound of the concrete values
+ */
+void Interval::meet(long lower, long upper)
+{
+  if(bottom){ return; }
+  
+  if(lower > upper){
+    bottom = true;
+    return;
+  }
+  
+  if(lower != numeric_limits<long>::min() && lower > lBound){
+    lBound = lower;
+  }
+  if(upper != numeric_limits<long>::max() && upper < rBound){
+    rBound = upper;
+  }
+  clamp();
+  if(lBound > rBound){ bottom = true; }
+}
+
+
+/** Bounds are brought back within the limits of short.
+ * Such limits represent infinity, so finite bounds which overflow them
+ * become infinite.
+ */
+void Interval::clamp()
+{
+  long min = numeric_limits<short>::min(), max = numeric_limits<short>::max();
+  
+  lBound = (lBound < min) ? min : (lBound > max) ? max : lBound;
+  rBound = (rBound < min) ? min : (rBound > max) ? max : rBound;
+}
+
+
+/** Opposite of a bound.
+ * Opposite of an infinite bound is the opposite infinity.
+ * @param[in]  a           Bound
+ * @retval     long        Opposite bound
+ */
+long Interval::neg(long a)
+{
+  if(a >= numeric_limits<short>::max()){ return numeric_limits<short>::min(); }
+  if(a <= numeric_limits<short>::min()){ return numeric_limits<short>::max(); }
+  return -a;
+}
+
+
+/** Product of two bounds.
+ * Product of an infinite bound and a non zero one is infinite, products
+ * which overflow the limits of short become infinite.
+ * @param[in]  a           First bound
+ * @param[in]  b           Second bound
+ * @retval     long        Product of the bounds
+ */
+long Interval::product(long a, long b)
+{
+  long min = numeric_limits<short>::min(), max = numeric_limits<short>::max();
+  
+  if(a == 0 || b == 0){ return 0L; }
+  if(a <= min || a >= max || b <= min || b >= max){
+    return ((a < 0) == (b < 0)) ? max : min;
+  }
+  a *= b;
+  return (a < min) ? min : (a > max) ? max : a;
+}
+
+
+/** Integer quotient of two bounds.
+ * Divisor shall not be zero. Infinite dividends give infinite
+ * quotients, finite dividends divided by an infinite bound give zero.
+ * @param[in]  a           Dividend
+ * @param[in]  b           Divisor
+ * @retval     long        Quotient of the bounds
+ */
+long Interval::quotient(long a, long b)
+{
+  long min = numeric_limits<short>::min(), max = numeric_limits<short>::max();
+  
+  if(b <= min || b >= max){ return 0L; }
+  if(a <= min || a >= max){ return ((a < 0) == (b < 0)) ? max : min; }
+  return a / b;
+}
+
+
+/** Power of a bound.
+ * Exponents from 16 on saturate every base but -1, 0 and 1, whose
+ * powers only depend on the parity of the exponent.
+ * @param[in]  a           Base
+ * @param[in]  e           Exponent, positive
+ * @retval     long        Power of the bound
+ */
+long Interval::power(long a, long e)
+{
+  long result = 1L;
+  
+  if(e > 16){ e = 16 + e % 2; }
+  while(e-- > 0){
+    result = product(result, a);
+  }
+  
+  return result;
+}
+
+
+/** Sum of two bounds.
+ * Infinity is absorbing: adding a finite bound to an infinite one gives
+ * the infinite bound back.
+ * @param[in]  a           First bound
+ * @param[in]  b           Second bound
+ * @retval     long        Sum of the bounds
+ */
+long Interval::add(long a, long b)
+{
+  if(a <= numeric_limits<short>::min() || b <= numeric_limits<short>::min()){
+    return numeric_limits<short>::min();
+  }
+  if(a >= numeric_limits<short>::max() || b >= numeric_limits<short>::max()){
+    return numeric_limits<short>::max();
+  }
+  return a + b;
+}
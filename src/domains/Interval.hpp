@@ -144,6 +144,14 @@ class Interval
   static bool equal(Interval a, Interval b);
   
   
+  /** Hash function.
+   * Values which are equal, according to equal(), have the same hash.
+   * @param[in]  a           Abstract value
+   * @retval     size_t      Hash of the value
+   */
+  static size_t hash(Interval a);
+  
+  
   /** Least upperbound between two values in the abstract domain is
    * computed.
    * @param[in]  a           First abstract value
@@ -154,7 +162,10 @@ class Interval
   
   
   /** Widening operator.
-   * No actual widening is used in the Interval domain.
+   * Bounds which grow are widened to the nearest threshold, see
+   * Thresholds, or to infinity if there is none. Bounds which do not
+   * grow are kept from the previous value, so that the result never
+   * shrinks even when the current value was narrowed by a reduction.
    * @param[in]  a           Previous value
    * @param[in]  b           Current value
    * @retval     Interval    Widened value
@@ -185,9 +196,84 @@ class Interval
   static Interval top();
   
   
+  /** Bounds of the concrete values are provided.
+   * This method is used by reduced products to exchange information
+   * between domains. Missing bounds are represented by the limits of
+   * long, bottom is represented by an empty range.
+   * @param[out] lower       Lower bound of the concrete values
+   * @param[out] upper       Upper bound of the concrete values
+   */
+  void bounds(long &lower, long &upper);
+  
+  
+  /** Value is refined by the given bounds.
+   * This method is used by reduced products to exchange information
+   * between domains. Value becomes bottom if the range is empty. Bounds
+   * beyond the limits of short become infinite, as they do everywhere.
+   * @param[in]  lower       Lower bound of the concrete values
+   * @param[in]  upper       Upper bound of the concrete values
+   */
+  void meet(long lower, long upper);
+  
+  
   private:
   bool bottom;          ///< True if the value is bottom
   long lBound;          ///< Left bound of the interval
   long rBound;          ///< Right bound of the interval
+  
+  
+  /** Bounds are brought back within the limits of short.
+   * Such limits represent infinity, so finite bounds which overflow them
+   * become infinite.
+   */
+  void clamp();
+  
+  
+  /** Opposite of a bound.
+   * Opposite of an infinite bound is the opposite infinity.
+   * @param[in]  a           Bound
+   * @retval     long        Opposite bound
+   */
+  static long neg(long a);
+  
+  
+  /** Product of two bounds.
+   * Product of an infinite bound and a non zero one is infinite,
+   * products which overflow the limits of short become infinite.
+   * @param[in]  a           First bound
+   * @param[in]  b           Second bound
+   * @retval     long        Product of the bounds
+   */
+  static long product(long a, long b);
+  
+  
+  /** Integer quotient of two bounds.
+   * Divisor shall not be zero. Infinite dividends give infinite
+   * quotients, finite dividends divided by an infinite bound give zero.
+   * @param[in]  a           Dividend
+   * @param[in]  b           Divisor
+   * @retval     long        Quotient of the bounds
+   */
+  static long quotient(long a, long b);
+  
+  
+  /** Power of a bound.
+   * Exponents from 16 on saturate every base but -1, 0 and 1, whose
+   * powers only depend on the parity of the exponent.
+   * @param[in]  a           Base
+   * @param[in]  e           Exponent, positive
+   * @retval     long        Power of the bound
+   */
+  static long power(long a, long e);
+  
+  
+  /** Sum of two bounds.
+   * Infinity is absorbing: adding a finite bound to an infinite one
+   * gives the infinite bound back.
+   * @param[in]  a           First bound
+   * @param[in]  b           Second bound
+   * @retval     long        Sum of the bounds
+   */
+  static long add(long a, long b);
 };
 #endif
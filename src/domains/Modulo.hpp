@@ -10,6 +10,7 @@
 #define MODULO_H
 
 #include <stdio.h>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -250,13 +251,14 @@ class Modulo
    */
   operator const char * ()
   {
-    char buff[32];
+    static thread_local char buff[32];
     
     switch(carry){
       case BOT: return "bot";
       case NUM:
-        sprintf(buff, "%d", value);
-        return string(buff).c_str();
+        // Text is kept in a per-thread buffer, which outlives the call.
+        snprintf(buff, sizeof(buff), "%d", value);
+        return buff;
       case TOP: return "top";
       default:  return "top";
     }
@@ -275,6 +277,17 @@ class Modulo
          ? a.value == b.value
          : a.carry == b.carry;
   }
+  
+  
+  /** Hash function.
+   * Values which are equal, according to equal(), have the same hash.
+   * @param[in]  a           Abstract value
+   * @retval     size_t      Hash of the value
+   */
+  static size_t hash(Modulo<N> a)
+  {
+    return (a.carry == NUM) ? (size_t) a.value * 31 + NUM : (size_t) a.carry;
+  }
 
 
   /** Least upperbound between two values in the abstract domain is
@@ -367,6 +380,44 @@ class Modulo
   }
   
   
+  /** Bounds of the concrete values are provided.
+   * This method is used by reduced products to exchange information
+   * between domains. Remainders do not bound the concrete values, so
+   * only bottom is reported, as an empty range.
+   * @param[out] lower       Lower bound of the concrete values
+   * @param[out] upper       Upper bound of the concrete values
+   */
+  void bounds(long &lower, long &upper)
+  {
+    lower = (carry == BOT) ? 1L : numeric_limits<long>::min();
+    upper = (carry == BOT) ? 0L : numeric_limits<long>::max();
+  }
+  
+  
+  /** Value is refined by the given bounds.
+   * This method is used by reduced products to exchange information
+   * between domains. Value becomes bottom if the range is empty, and
+   * it becomes the remainder of the only concrete value if the range is
+   * a singleton.
+   * @param[in]  lower       Lower bound of the concrete values
+   * @param[in]  upper       Upper bound of the concrete values
+   */
+  void meet(long lower, long upper)
+  {
+    if(carry == BOT || N == 0){ return; }
+    
+    if(lower > upper){
+      carry = BOT;
+    }
+    else if(lower == upper){
+      // Remainders are compared modulo N, since their sign is not kept
+      // consistently by the arithmetic operators.
+      if(carry == NUM && (value - lower % N) % N != 0){ carry = BOT; }
+      else{ *this = alpha(lower); }
+    }
+  }
+  
+  
   private:
   /** Type representing classes of possible abstract values. */
   typedef enum{
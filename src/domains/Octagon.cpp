@@ -0,0 +1,689 @@
+/** Octagon abstract interpretation.
+ * Class handling the abstract interpretation in the Octagon relational
+ * abstract domain, and the abstract state over it.
+ *
+ * @file Octagon.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ * @ingroup domains
+ */
+#include <algorithm>
+#include <limits>
+#include <functional>
+
+#include "Octagon.hpp"
+
+
+// Infinity leaves room for the sum of two entries, so that the closure
+// kernel needs no test; entries from half of it on are infinite.
+const int32_t Octagon::Inf = 1 << 28;
+
+unsigned long AbstractState<Octagon>::copies      = 0;
+unsigned long AbstractState<Octagon>::comparisons = 0;
+
+vector<unsigned int> AbstractState<Octagon>::packing;
+
+
+/** Largest integer not greater than half of a value.
+ * @param[in]  v           Value
+ * @retval     long        Floor of v / 2
+ */
+static long halve(long v)
+{
+  return (v >= 0) ? v / 2 : -((1 - v) / 2);
+}
+
+
+/** Opposite of a bound, where the limits of long stand for infinity.
+ * @param[in]  v           Bound
+ * @retval     long        Opposite of the bound
+ */
+static long opposite(long v)
+{
+  if(v == numeric_limits<long>::min()){ return numeric_limits<long>::max(); }
+  if(v == numeric_limits<long>::max()){ return numeric_limits<long>::min(); }
+  return -v;
+}
+
+
+/** Sum of two bounds of the same side, where the limits of long stand
+ * for infinity and are absorbing.
+ * @param[in]  a           First bound
+ * @param[in]  b           Second bound
+ * @retval     long        Sum of the bounds
+ */
+static long total(long a, long b)
+{
+  if(a == numeric_limits<long>::min() || a == numeric_limits<long>::max()){
+    return a;
+  }
+  if(b == numeric_limits<long>::min() || b == numeric_limits<long>::max()){
+    return b;
+  }
+  return a + b;
+}
+
+
+/** Bound of a variable, or of a sum, is printed.
+ * @param[out] out         Output stream
+ * @param[in]  label       Bounded expression
+ * @param[in]  lower       Lower bound, the limit of long if missing
+ * @param[in]  upper       Upper bound, the limit of long if missing
+ */
+static void print(ostream &out, const string &label, long lower, long upper)
+{
+  out << label << " -> "
+      << ((lower == numeric_limits<long>::min())
+          ? "(-inf" : "[" + to_string(lower)) << "; "
+      << ((upper == numeric_limits<long>::max())
+          ? "+inf)" : to_string(upper) + "]") << ", ";
+}
+
+
+/** Constructor of the octagon with no constraints.
+ * @param[in]  variables   Number of variables
+ */
+Octagon::Octagon(unsigned int variables)
+{
+  unsigned int i;
+
+  size = 2 * variables;
+  half.assign(position(size, 0), Inf);
+  bound.assign(variables, false);
+  empty = false;
+
+  for(i = 0; i < size; ++i){ at(i, i) = 0; }
+}
+
+
+/** 'Less than or equal to' operator overloading.
+ * @param[in]  other       Octagon to be compared
+ * @retval     bool        True if every bound of the current octagon
+ *                         is at least as tight as the one in the other
+ */
+bool Octagon::operator<=(const Octagon &other) const
+{
+  size_t i;
+
+  if(empty || other.empty){ return empty; }
+  for(i = 0; i < half.size(); ++i){
+    if(half[i] > other.half[i]){ return false; }
+  }
+
+  return true;
+}
+
+
+/** 'Equal to' operator overloading.
+ * @param[in]  other       Octagon to be compared
+ * @retval     bool        True if and only if octagons have the same
+ *                         bounds and the same bound variables
+ */
+bool Octagon::operator==(const Octagon &other) const
+{
+  if(empty || other.empty){ return empty == other.empty; }
+  return bound == other.bound && half == other.half;
+}
+
+
+/** Predicate testing whether the octagon has no concrete value.
+ * @retval     bool        True if constraints are not satisfiable
+ */
+bool Octagon::isEmpty() const
+{
+  return empty;
+}
+
+
+/** Variable is assigned a value within the given bounds.
+ * Missing bounds are represented by the limits of long.
+ * @param[in]  x           Index of the assigned variable
+ * @param[in]  lower       Lower bound of the value
+ * @param[in]  upper       Upper bound of the value
+ */
+void Octagon::assign(unsigned int x, long lower, long upper)
+{
+  forget(x);
+  if(upper != numeric_limits<long>::max()){
+    at(2 * x + 1, 2 * x) = clamp(2 * upper);
+  }
+  if(lower != numeric_limits<long>::min()){
+    at(2 * x, 2 * x + 1) = clamp(-2 * lower);
+  }
+  bound[x] = true;
+  close(x);
+}
+
+
+/** Variable is assigned another variable, or its opposite, plus a
+ * constant. If variables are the same one, literals of the variable are
+ * swapped for the opposite, then shifted by the constant, which keeps
+ * the matrix closed. Otherwise, the variable is forgotten and bound to
+ * the other one by two constraints.
+ * @param[in]  x           Index of the assigned variable
+ * @param[in]  sign        Sign of the variable in the expression
+ * @param[in]  y           Index of the variable in the expression
+ * @param[in]  c           Constant in the expression
+ */
+void Octagon::assign(unsigned int x, int sign, unsigned int y, long c)
+{
+  unsigned int p = 2 * x, n = 2 * x + 1, i;
+
+  if(x != y){
+    forget(x);
+    at(literal(sign, y), p) = clamp(c);
+    at(p, literal(sign, y)) = clamp(-c);
+    bound[x] = true;
+    close(x);
+    return;
+  }
+
+  for(i = 0; i < size; ++i){
+    if(i == p || i == n){ continue; }
+    if(sign < 0){ swap(at(i, p), at(i, n)); }
+    at(i, p) = add(at(i, p), c);
+    at(i, n) = add(at(i, n), -c);
+  }
+  if(sign < 0){ swap(at(n, p), at(p, n)); }
+  at(n, p) = add(at(n, p), 2 * c);
+  at(p, n) = add(at(p, n), -2 * c);
+  bound[x] = true;
+}
+
+
+/** Every constraint on a variable is removed.
+ * @param[in]  x           Index of the variable
+ */
+void Octagon::forget(unsigned int x)
+{
+  unsigned int i;
+
+  for(i = 0; i < size; ++i){
+    at(i, 2 * x)     = Inf;
+    at(i, 2 * x + 1) = Inf;
+  }
+  at(2 * x, 2 * x)         = 0;
+  at(2 * x + 1, 2 * x + 1) = 0;
+  bound[x] = false;
+}
+
+
+/** Constraint sx x + sy y <= c is added, for distinct variables.
+ * Octagon may become empty.
+ * @param[in]  sx          Sign of the first variable
+ * @param[in]  x           Index of the first variable
+ * @param[in]  sy          Sign of the second variable
+ * @param[in]  y           Index of the second variable
+ * @param[in]  c           Bound of the sum
+ */
+void Octagon::constrain(int sx, unsigned int x, int sy, unsigned int y, long c)
+{
+  int32_t &entry = at(literal(-sy, y), literal(sx, x));
+
+  if(empty || clamp(c) >= entry){ return; }
+  entry = clamp(c);
+  close(x);
+}
+
+
+/** Variable is refined by the given bounds.
+ * Missing bounds are represented by the limits of long. Octagon may
+ * become empty.
+ * @param[in]  x           Index of the variable
+ * @param[in]  lower       Lower bound of the variable
+ * @param[in]  upper       Upper bound of the variable
+ */
+void Octagon::meet(unsigned int x, long lower, long upper)
+{
+  int32_t &up = at(2 * x + 1, 2 * x), &down = at(2 * x, 2 * x + 1);
+  bool changed = false;
+
+  if(empty){ return; }
+  if(lower > upper){
+    empty = true;
+    return;
+  }
+  if(upper != numeric_limits<long>::max() && clamp(2 * upper) < up){
+    up      = clamp(2 * upper);
+    changed = true;
+  }
+  if(lower != numeric_limits<long>::min() && clamp(-2 * lower) < down){
+    down    = clamp(-2 * lower);
+    changed = true;
+  }
+  if(changed){ close(x); }
+}
+
+
+/** Bounds of a variable are provided.
+ * Missing bounds are represented by the limits of long.
+ * @param[in]  x           Index of the variable
+ * @param[out] lower       Lower bound of the variable
+ * @param[out] upper       Upper bound of the variable
+ */
+void Octagon::bounds(unsigned int x, long &lower, long &upper) const
+{
+  int32_t up = at(2 * x + 1, 2 * x), down = at(2 * x, 2 * x + 1);
+
+  lower = (down == Inf) ? numeric_limits<long>::min() : -halve(down);
+  upper = (up   == Inf) ? numeric_limits<long>::max() :  halve(up);
+}
+
+
+/** Bounds of sx x + sy y are provided, for distinct variables.
+ * Missing bounds are represented by the limits of long.
+ * @param[in]  sx          Sign of the first variable
+ * @param[in]  x           Index of the first variable
+ * @param[in]  sy          Sign of the second variable
+ * @param[in]  y           Index of the second variable
+ * @param[out] lower       Lower bound of the sum
+ * @param[out] upper       Upper bound of the sum
+ */
+void Octagon::range(int sx, unsigned int x, int sy, unsigned int y,
+                    long &lower, long &upper) const
+{
+  unsigned int i = literal(-sy, y), j = literal(sx, x);
+  int32_t up = at(i, j), down = at(i ^ 1, j ^ 1);
+
+  lower = (down == Inf) ? numeric_limits<long>::min() : -down;
+  upper = (up   == Inf) ? numeric_limits<long>::max() : up;
+}
+
+
+/** Least upperbound with the given octagon is computed in place.
+ * Loosest bound of each entry is kept, which keeps closed matrices
+ * closed.
+ * @param[in]  other       Octagon to be joined with the current one
+ */
+void Octagon::join(const Octagon &other)
+{
+  size_t i;
+
+  if(other.empty){ return; }
+  if(empty){
+    *this = other;
+    return;
+  }
+  for(i = 0; i < half.size(); ++i){ half[i] = max(half[i], other.half[i]); }
+  for(i = 0; i < bound.size(); ++i){
+    bound[i] = bound[i] || other.bound[i];
+  }
+}
+
+
+/** Widening is applied in place.
+ * Bounds which grew since the previous octagon are removed.
+ * @param[in]  previous    Octagon reached by the previous iteration
+ */
+void Octagon::widen(const Octagon &previous)
+{
+  size_t i;
+
+  if(empty || previous.empty){ return; }
+  for(i = 0; i < half.size(); ++i){
+    if(half[i] > previous.half[i]){ half[i] = Inf; }
+  }
+}
+
+
+/** Every bound which changed since the previous octagon is removed.
+ * @param[in]  previous    Octagon reached by the previous iteration
+ */
+void Octagon::saturate(const Octagon &previous)
+{
+  size_t i;
+
+  if(empty || previous.empty){ return; }
+  for(i = 0; i < half.size(); ++i){
+    if(half[i] != previous.half[i]){ half[i] = Inf; }
+  }
+}
+
+
+/** Hash function.
+ * Octagons which are equal have the same hash.
+ * @retval     size_t      Hash of the octagon
+ */
+size_t Octagon::hash() const
+{
+  size_t h = 0, i;
+
+  if(empty){ return 0; }
+  for(i = 0; i < half.size(); ++i){
+    h = h * 31 + std::hash<int32_t>()(half[i]);
+  }
+
+  return h;
+}
+
+
+/** A textual representation of the bounds of a variable is provided.
+ * Nothing is printed if the variable is not bound.
+ * @param[out] out         Output stream
+ * @param[in]  x           Index of the variable
+ * @param[in]  name        Name of the variable
+ */
+void Octagon::dump(ostream &out, unsigned int x, const string &name) const
+{
+  long lower, upper;
+
+  if(!bound[x]){ return; }
+  bounds(x, lower, upper);
+  print(out, name, lower, upper);
+}
+
+
+/** A textual representation of the relations is provided.
+ * Sums and differences of bound variables are listed, if they are
+ * tighter than the ones implied by the bounds of the variables.
+ * @param[out] out         Output stream
+ * @param[in]  names       Name of each variable
+ */
+void Octagon::dumpRelations(ostream &out, const vector<string> &names) const
+{
+  unsigned int variables = size / 2, x, y;
+  int sign;
+  vector<long> lower(variables), upper(variables);
+  long down, up;
+
+  for(x = 0; x < variables; ++x){
+    bounds(x, lower[x], upper[x]);
+  }
+
+  for(x = 0; x < variables; ++x){
+    for(y = x + 1; y < variables; ++y){
+      if(!bound[x] || !bound[y]){ continue; }
+      for(sign = -1; sign <= 1; sign += 2){
+        range(1, y, sign, x, down, up);
+        if(down <= total(lower[y], sign > 0 ? lower[x] : opposite(upper[x]))
+        && up   >= total(upper[y], sign > 0 ? upper[x] : opposite(lower[x]))){
+          continue;
+        }
+        print(out, names[y] + (sign > 0 ? " + " : " - ") + names[x],
+              down, up);
+      }
+    }
+  }
+}
+
+
+/** Row of a dense matrix is relaxed through a pivot row.
+ * Entry j of the row becomes min(row[j], through + pivot[j]), but not
+ * lower than the opposite of half of infinity. Loop has no branch, and
+ * infinity is small enough not to overflow, so that it is vectorized
+ * into packed additions and minimums; an infinite pivot entry leaves a
+ * sum from half of infinity on, which is still infinite.
+ * @param[in,out] row      Row to be relaxed
+ * @param[in]  pivot       Row of the pivot literal
+ * @param[in]  through     Entry of the row in the pivot column
+ * @param[in]  size        Length of the rows
+ */
+void Octagon::relax(int32_t *row, const int32_t *pivot, int32_t through,
+                    unsigned int size)
+{
+  const int32_t floor = -Inf / 2;
+  unsigned int j;
+
+  if(through >= Inf / 2){ return; }
+  for(j = 0; j < size; ++j){
+    row[j] = max(min(row[j], through + pivot[j]), floor);
+  }
+}
+
+
+/** Matrix is strongly closed after the rows of a variable changed.
+ * Matrix is expanded into a dense one, whose rows are contiguous. Rows
+ * of the variable are relaxed through every other literal, mirroring
+ * them into the columns of the variable after each pair of literals,
+ * then every row is relaxed through the literals of the variable, which
+ * is a full Floyd-Warshall step restricted to the entries which may
+ * have changed. Bounds of the variables are then made even, as values
+ * are integers, and every entry is strengthened by the bounds of its
+ * literals. Octagon is empty if the diagonal becomes negative.
+ * @param[in]  x           Index of the updated variable
+ */
+void Octagon::close(unsigned int x)
+{
+  static thread_local vector<int32_t> dense;
+  static thread_local vector<int32_t> unary;
+  const unsigned int p = 2 * x, n = 2 * x + 1;
+  unsigned int i, j, k, pass;
+  int32_t *rowP, *rowN, *row;
+
+  // Lower half is copied row by row, the upper one is coherent to it.
+  dense.resize((size_t) size * size);
+  unary.resize(size);
+  for(i = 0; i < size; ++i){
+    copy(&half[position(i, 0)], &half[position(i, 0)] + (i | 1) + 1,
+         &dense[(size_t) i * size]);
+  }
+  for(i = 0; i < size; ++i){
+    for(j = (i | 1) + 1; j < size; ++j){
+      dense[(size_t) i * size + j] = dense[(size_t) (j ^ 1) * size + (i ^ 1)];
+    }
+  }
+  rowP = &dense[(size_t) p * size];
+  rowN = &dense[(size_t) n * size];
+
+  // Rows of the variable, through every other literal.
+  for(k = 0; k < size; k += 2){
+    if(k == p){ continue; }
+    for(pass = 0; pass < 2; ++pass){
+      relax(rowP, &dense[(size_t) k * size],       rowP[k],     size);
+      relax(rowP, &dense[(size_t) (k + 1) * size], rowP[k + 1], size);
+      relax(rowN, &dense[(size_t) k * size],       rowN[k],     size);
+      relax(rowN, &dense[(size_t) (k + 1) * size], rowN[k + 1], size);
+      for(j = 0; j < size; ++j){
+        dense[(size_t) j * size + p] = rowN[j ^ 1];
+        dense[(size_t) j * size + n] = rowP[j ^ 1];
+      }
+    }
+  }
+
+  // Every row, through the literals of the variable.
+  for(i = 0; i < size; ++i){
+    row = &dense[(size_t) i * size];
+    relax(row, rowP, row[p], size);
+    relax(row, rowN, row[n], size);
+  }
+
+  // Tightening and strengthening, where an infinite bound of a literal
+  // is doubled so that halved sums through it are still infinite.
+  for(i = 0; i < size; ++i){
+    row = &dense[(size_t) i * size];
+    if(row[i ^ 1] < Inf / 2){ row[i ^ 1] = 2 * halve(row[i ^ 1]); }
+  }
+  for(j = 0; j < size; ++j){
+    unary[j] = dense[(size_t) (j ^ 1) * size + j];
+    if(unary[j] >= Inf / 2){ unary[j] = 2 * Inf; }
+  }
+  for(i = 0; i < size; ++i){
+    row = &dense[(size_t) i * size];
+    if(row[i ^ 1] >= Inf / 2){ continue; }
+    for(j = 0; j < size; ++j){
+      row[j] = min(row[j], (row[i ^ 1] + unary[j]) >> 1);
+    }
+  }
+
+  // Lower half is rebuilt, taking the tightest of coherent entries.
+  for(i = 0; i < size; ++i){
+    if(dense[(size_t) i * size + i] < 0){ empty = true; }
+    for(j = 0; j <= (i | 1); ++j){
+      half[position(i, j)] = clamp(min(dense[(size_t) i * size + j],
+                                   dense[(size_t) (j ^ 1) * size + (i ^ 1)]));
+    }
+  }
+}
+
+
+/** Constructor of a state with no constraints.
+ * Variables are packed as set by setPacks(), or all together if no
+ * packing has been set for as many variables.
+ * @param[in]  names       Name of the variable in each slot
+ */
+AbstractState<Octagon>::AbstractState(const vector<string> *names)
+{
+  shared_ptr<Layout> l = make_shared<Layout>();
+  unsigned int var, p;
+
+  l->pack = (packing.size() == names->size())
+          ? packing : vector<unsigned int>(names->size(), 0);
+  l->index.resize(names->size());
+  l->names.resize(1);
+  for(var = 0; var < names->size(); ++var){
+    p = l->pack[var];
+    if(p >= l->names.size()){ l->names.resize(p + 1); }
+    l->index[var] = l->names[p].size();
+    l->names[p].push_back((*names)[var]);
+  }
+
+  for(p = 0; p < l->names.size(); ++p){
+    octagons.push_back(make_shared<Octagon>(l->names[p].size()));
+  }
+  layout = l;
+}
+
+
+/** 'Less than or equal to' operator overloading.
+ * @param[in]  other       Abstract state to be compared
+ * @retval     bool        True if the current state is included in
+ *                         the other one
+ */
+bool AbstractState<Octagon>::operator<=(const AbstractState<Octagon> &other)
+const
+{
+  size_t p;
+
+  if(isBottom() || other.isBottom()){ return isBottom(); }
+  for(p = 0; p < octagons.size(); ++p){
+    if(octagons[p] != other.octagons[p]
+    && !(*octagons[p] <= *other.octagons[p])){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/** 'Equal to' operator overloading.
+ * Packs sharing the same octagon are equal without any comparison.
+ * @param[in]  other       Abstract state to be compared
+ * @retval     bool        True if and only if states are the same
+ */
+bool AbstractState<Octagon>::operator==(const AbstractState<Octagon> &other)
+const
+{
+  size_t p;
+  bool compared = false;
+
+  if(isBottom() || other.isBottom()){ return isBottom() == other.isBottom(); }
+  for(p = 0; p < octagons.size(); ++p){
+    if(octagons[p] == other.octagons[p]){ continue; }
+    if(!compared){
+      ++comparisons;
+      compared = true;
+    }
+    if(!(*octagons[p] == *other.octagons[p])){ return false; }
+  }
+
+  return true;
+}
+
+
+/** A textual representation of the state is provided.
+ * Bounds of the variables are listed by slot, hence by name, as every
+ * other domain does, then the relations within each pack.
+ * @param[out] out         Output stream
+ */
+void AbstractState<Octagon>::dump(ostream &out) const
+{
+  unsigned int var;
+  size_t p;
+
+  if(isBottom()){
+    out << "bot" << endl;
+    return;
+  }
+  out << "[";
+  for(var = 0; var < layout->pack.size(); ++var){
+    octagon(var).dump(out, local(var), layout->names[pack(var)][local(var)]);
+  }
+  for(p = 0; p < octagons.size(); ++p){
+    octagons[p]->dumpRelations(out, layout->names[p]);
+  }
+  out << "]" << endl;
+}
+
+
+/** Least upperbound with the given state is computed in place.
+ * Packs sharing the same octagon are skipped.
+ * @param[in]  other       State to be joined with the current one
+ */
+void AbstractState<Octagon>::join(const AbstractState<Octagon> &other)
+{
+  size_t p;
+
+  if(other.isBottom()){ return; }
+  if(isBottom()){
+    *this = other;
+    return;
+  }
+  for(p = 0; p < octagons.size(); ++p){
+    if(octagons[p] != other.octagons[p]){ update(p).join(*other.octagons[p]); }
+  }
+}
+
+
+/** Widening is applied in place.
+ * @param[in]  previous    State reached by the previous iteration
+ */
+void AbstractState<Octagon>::widen(const AbstractState<Octagon> &previous)
+{
+  size_t p;
+
+  if(isBottom() || previous.isBottom()){ return; }
+  for(p = 0; p < octagons.size(); ++p){
+    if(octagons[p] != previous.octagons[p]){
+      update(p).widen(*previous.octagons[p]);
+    }
+  }
+}
+
+
+/** Every bound which changed since the previous state is removed.
+ * @param[in]  previous    State reached by the previous iteration
+ */
+void AbstractState<Octagon>::saturate(const AbstractState<Octagon> &previous)
+{
+  size_t p;
+
+  if(isBottom() || previous.isBottom()){ return; }
+  for(p = 0; p < octagons.size(); ++p){
+    if(octagons[p] != previous.octagons[p]){
+      update(p).saturate(*previous.octagons[p]);
+    }
+  }
+}
+
+
+/** Fingerprint of the state is returned.
+ * @retval     size_t      Hash of the octagons
+ */
+size_t AbstractState<Octagon>::fingerprint() const
+{
+  size_t h = 0, p;
+
+  for(p = 0; p < octagons.size(); ++p){ h = h * 31 + octagons[p]->hash(); }
+
+  return h;
+}
+
+
+/** Packing of the variables is set.
+ * @param[in]  packs       Pack of the variable in each slot, packs
+ *                         being numbered from 0
+ */
+void AbstractState<Octagon>::setPacks(const vector<unsigned int> &packs)
+{
+  packing = packs;
+}
@@ -0,0 +1,608 @@
+/** Octagon abstract interpretation.
+ * Class handling the abstract interpretation in the Octagon relational
+ * abstract domain, and the abstract state over it.
+ *
+ * @file Octagon.hpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ * @ingroup domains
+ */
+#ifndef _OCTAGON_HPP_
+#define _OCTAGON_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../AbstractState.hpp"
+
+using namespace std;
+
+/** Class representing the octagon domain abstraction.
+ * An octagon is a conjunction of constraints +-x +-y <= c, so that,
+ * unlike zones, also sums of variables are bounded. Every variable x
+ * is split into a positive literal +x, of index 2x, and a negative one
+ * -x, of index 2x + 1: entry (i, j) of the matrix bounds v_j - v_i, and
+ * bounds of x are kept as bounds of +x - -x = 2x. Entries (i, j) and
+ * (j ^ 1, i ^ 1) bound the same quantity, hence only the lower half of
+ * the matrix is stored, row by row: row i keeps columns up to i | 1.
+ * Entries are 32 bit integers, so that the octagon takes 8 n (n + 1)
+ * bytes for n variables: bounds beyond 2^27 are dropped, and bounds
+ * below -2^27 are loosened, which are both sound.
+ *
+ * Matrix is kept strongly closed by incremental closure: only the rows
+ * of the updated variable are relaxed through every other literal, then
+ * every entry is relaxed through the updated variable, in O(n^2) min-plus
+ * row updates over a dense copy of the matrix, whose rows are contiguous
+ * and have no branch, so that the compiler vectorizes them into packed
+ * 32 bit additions and minimums. Widened matrices are not closed again,
+ * so that widening terminates.
+ */
+class Octagon
+{
+  public:
+  /** Constructor of the octagon with no constraints.
+   * @param[in]  variables   Number of variables
+   */
+  Octagon(unsigned int variables);
+
+
+  /** 'Less than or equal to' operator overloading.
+   * @param[in]  other       Octagon to be compared
+   * @retval     bool        True if every bound of the current octagon
+   *                         is at least as tight as the one in the other
+   */
+  bool operator<=(const Octagon &other) const;
+
+
+  /** 'Equal to' operator overloading.
+   * @param[in]  other       Octagon to be compared
+   * @retval     bool        True if and only if octagons have the same
+   *                         bounds and the same bound variables
+   */
+  bool operator==(const Octagon &other) const;
+
+
+  /** Predicate testing whether the octagon has no concrete value.
+   * @retval     bool        True if constraints are not satisfiable
+   */
+  bool isEmpty() const;
+
+
+  /** Variable is assigned a value within the given bounds.
+   * Missing bounds are represented by the limits of long.
+   * @param[in]  x           Index of the assigned variable
+   * @param[in]  lower       Lower bound of the value
+   * @param[in]  upper       Upper bound of the value
+   */
+  void assign(unsigned int x, long lower, long upper);
+
+
+  /** Variable is assigned another variable, or its opposite, plus a
+   * constant. Variables may be the same one.
+   * @param[in]  x           Index of the assigned variable
+   * @param[in]  sign        Sign of the variable in the expression
+   * @param[in]  y           Index of the variable in the expression
+   * @param[in]  c           Constant in the expression
+   */
+  void assign(unsigned int x, int sign, unsigned int y, long c);
+
+
+  /** Every constraint on a variable is removed.
+   * @param[in]  x           Index of the variable
+   */
+  void forget(unsigned int x);
+
+
+  /** Constraint sx x + sy y <= c is added, for distinct variables.
+   * Octagon may become empty.
+   * @param[in]  sx          Sign of the first variable
+   * @param[in]  x           Index of the first variable
+   * @param[in]  sy          Sign of the second variable
+   * @param[in]  y           Index of the second variable
+   * @param[in]  c           Bound of the sum
+   */
+  void constrain(int sx, unsigned int x, int sy, unsigned int y, long c);
+
+
+  /** Variable is refined by the given bounds.
+   * Missing bounds are represented by the limits of long. Octagon may
+   * become empty.
+   * @param[in]  x           Index of the variable
+   * @param[in]  lower       Lower bound of the variable
+   * @param[in]  upper       Upper bound of the variable
+   */
+  void meet(unsigned int x, long lower, long upper);
+
+
+  /** Bounds of a variable are provided.
+   * Missing bounds are represented by the limits of long.
+   * @param[in]  x           Index of the variable
+   * @param[out] lower       Lower bound of the variable
+   * @param[out] upper       Upper bound of the variable
+   */
+  void bounds(unsigned int x, long &lower, long &upper) const;
+
+
+  /** Bounds of sx x + sy y are provided, for distinct variables.
+   * Missing bounds are represented by the limits of long.
+   * @param[in]  sx          Sign of the first variable
+   * @param[in]  x           Index of the first variable
+   * @param[in]  sy          Sign of the second variable
+   * @param[in]  y           Index of the second variable
+   * @param[out] lower       Lower bound of the sum
+   * @param[out] upper       Upper bound of the sum
+   */
+  void range(int sx, unsigned int x, int sy, unsigned int y,
+             long &lower, long &upper) const;
+
+
+  /** Least upperbound with the given octagon is computed in place.
+   * @param[in]  other       Octagon to be joined with the current one
+   */
+  void join(const Octagon &other);
+
+
+  /** Widening is applied in place.
+   * Bounds which grew since the previous octagon are removed.
+   * @param[in]  previous    Octagon reached by the previous iteration
+   */
+  void widen(const Octagon &previous);
+
+
+  /** Every bound which changed since the previous octagon is removed.
+   * @param[in]  previous    Octagon reached by the previous iteration
+   */
+  void saturate(const Octagon &previous);
+
+
+  /** Hash function.
+   * Octagons which are equal have the same hash.
+   * @retval     size_t      Hash of the octagon
+   */
+  size_t hash() const;
+
+
+  /** A textual representation of the bounds of a variable is provided.
+   * Nothing is printed if the variable is not bound.
+   * @param[out] out         Output stream
+   * @param[in]  x           Index of the variable
+   * @param[in]  name        Name of the variable
+   */
+  void dump(ostream &out, unsigned int x, const string &name) const;
+
+
+  /** A textual representation of the relations is provided.
+   * Sums and differences of bound variables are listed, if they are
+   * tighter than the ones implied by the bounds of the variables.
+   * @param[out] out         Output stream
+   * @param[in]  names       Name of each variable
+   */
+  void dumpRelations(ostream &out, const vector<string> &names) const;
+
+
+  private:
+  static const int32_t Inf;     ///< Missing bound
+
+  unsigned int    size;         ///< Number of literals, twice the
+                                ///<  number of variables
+  vector<int32_t> half;         ///< Lower half of the matrix, row by row
+  vector<bool>    bound;        ///< True for variables which have been
+                                ///<  assigned and not forgotten
+  bool            empty;        ///< True if the octagon is empty
+
+
+  /** Position of an entry in the lower half of the matrix.
+   * @param[in]  i           Row
+   * @param[in]  j           Column, not greater than i | 1
+   * @retval     size_t      Position of the entry
+   */
+  static size_t position(unsigned int i, unsigned int j)
+  {
+    return j + (size_t) (i + 1) * (i + 1) / 2;
+  }
+
+
+  /** Entry of the matrix, possibly stored as its coherent one.
+   * @param[in]  i           Row
+   * @param[in]  j           Column
+   * @retval     int32_t     Bound of v_j - v_i
+   */
+  int32_t &at(unsigned int i, unsigned int j)
+  {
+    return (j <= (i | 1)) ? half[position(i, j)]
+                          : half[position(j ^ 1, i ^ 1)];
+  }
+
+
+  /** Entry of the matrix, possibly stored as its coherent one.
+   * @param[in]  i           Row
+   * @param[in]  j           Column
+   * @retval     int32_t     Bound of v_j - v_i
+   */
+  int32_t at(unsigned int i, unsigned int j) const
+  {
+    return (j <= (i | 1)) ? half[position(i, j)]
+                          : half[position(j ^ 1, i ^ 1)];
+  }
+
+
+  /** Index of the literal of a variable with the given sign.
+   * @param[in]  sign        Sign of the variable
+   * @param[in]  x           Index of the variable
+   * @retval     unsigned int Index of the literal
+   */
+  static unsigned int literal(int sign, unsigned int x)
+  {
+    return (sign < 0) ? 2 * x + 1 : 2 * x;
+  }
+
+
+  /** Bound is brought into the range of the entries.
+   * Bounds from half of infinity on are infinite, and bounds below the
+   * opposite of that are loosened to it.
+   * @param[in]  v           Bound
+   * @retval     int32_t     Entry representing the bound
+   */
+  static int32_t clamp(long v)
+  {
+    return (v >= Inf / 2) ? Inf : (v < -Inf / 2) ? -Inf / 2 : (int32_t) v;
+  }
+
+
+  /** Constant is added to an entry, infinity is absorbing.
+   * @param[in]  a           Entry
+   * @param[in]  c           Constant
+   * @retval     int32_t     Entry representing the sum
+   */
+  static int32_t add(int32_t a, long c)
+  {
+    return (a == Inf) ? Inf : clamp(a + c);
+  }
+
+
+  /** Row of a dense matrix is relaxed through a pivot row.
+   * @param[in,out] row      Row to be relaxed
+   * @param[in]  pivot       Row of the pivot literal
+   * @param[in]  through     Entry of the row in the pivot column
+   * @param[in]  size        Length of the rows
+   */
+  static void relax(int32_t *row, const int32_t *pivot, int32_t through,
+                    unsigned int size);
+
+
+  /** Matrix is strongly closed after the rows of a variable changed.
+   * @param[in]  x           Index of the updated variable
+   */
+  void close(unsigned int x);
+};
+
+
+/** Template specialization representing an abstract state over octagons.
+ * Interface is the same as the one of the state over zones, so that
+ * assignments and guards are handled by the AST in the same way.
+ * Variables are partitioned into packs, see setPacks(), and every pack
+ * has its own octagon: variables in different packs are never related,
+ * but a cubic closure over many small octagons is much cheaper than the
+ * one over a single large octagon. Every octagon is shared among copies
+ * of the state and it is copied only when a shared state updates it.
+ */
+template <>
+class AbstractState<Octagon>
+{
+  public:
+  /** Constructor of the bottom state. */
+  AbstractState() {}
+
+
+  /** Constructor of a state with no constraints.
+   * Variables are packed as set by setPacks(), or all together if no
+   * packing has been set for as many variables.
+   * @param[in]  names       Name of the variable in each slot
+   */
+  AbstractState(const vector<string> *names);
+
+
+  /** Copy constructor.
+   * Octagons are shared, so copying takes time linear in the number of
+   * packs. Copies are counted, see AbstractState::copies.
+   * @param[in]  other       State to be copied
+   */
+  AbstractState(const AbstractState<Octagon> &other)
+    : layout(other.layout), octagons(other.octagons)
+  {
+    ++copies;
+  }
+
+
+  /** Move constructor.
+   * @param[in]  other       State to be moved
+   */
+  AbstractState(AbstractState<Octagon> &&other) noexcept = default;
+
+
+  /** Copy assignment operator overloading.
+   * @param[in]  other       State to be copied
+   * @retval     AbstractState Reference to the current state
+   */
+  AbstractState<Octagon> &operator=(const AbstractState<Octagon> &other)
+  {
+    layout   = other.layout;
+    octagons = other.octagons;
+    ++copies;
+    return *this;
+  }
+
+
+  /** Move assignment operator overloading.
+   * @param[in]  other       State to be moved
+   * @retval     AbstractState Reference to the current state
+   */
+  AbstractState<Octagon> &operator=(AbstractState<Octagon> &&other) noexcept
+    = default;
+
+
+  /** 'Less than or equal to' operator overloading.
+   * @param[in]  other       Abstract state to be compared
+   * @retval     bool        True if the current state is included in
+   *                         the other one
+   */
+  bool operator<=(const AbstractState<Octagon> &other) const;
+
+
+  /** 'Equal to' operator overloading.
+   * Packs sharing the same octagon are equal without any comparison.
+   * @param[in]  other       Abstract state to be compared
+   * @retval     bool        True if and only if states are the same
+   */
+  bool operator==(const AbstractState<Octagon> &other) const;
+
+
+  /** 'Not equal to' operator overloading.
+   * @param[in]  other       Abstract state to be compared
+   * @retval     bool        True if and only if states are different
+   */
+  bool operator!=(const AbstractState<Octagon> &other) const
+  {
+    return !(*this == other);
+  }
+
+
+  /** Variable is assigned a value within the given bounds.
+   * @param[in]  var         Slot of the assigned variable
+   * @param[in]  lower       Lower bound of the value
+   * @param[in]  upper       Upper bound of the value
+   */
+  void assign(unsigned int var, long lower, long upper)
+  {
+    if(!isBottom()){ update(pack(var)).assign(local(var), lower, upper); }
+  }
+
+
+  /** Variable is assigned another variable, or its opposite, plus a
+   * constant. Relation is kept only within a pack.
+   * @param[in]  var         Slot of the assigned variable
+   * @param[in]  sign        Sign of the variable in the expression
+   * @param[in]  other       Slot of the variable in the expression
+   * @param[in]  c           Constant in the expression
+   * @retval     bool        False if variables are in different packs,
+   *                         in which case state is not updated
+   */
+  bool assign(unsigned int var, int sign, unsigned int other, long c)
+  {
+    if(!related(var, other)){ return false; }
+    if(!isBottom()){
+      update(pack(var)).assign(local(var), sign, local(other), c);
+    }
+    return true;
+  }
+
+
+  /** Constraint sx x + sy y <= c is added, for distinct variables.
+   * State becomes bottom if the constraint is not satisfiable.
+   * @param[in]  sx          Sign of the first variable
+   * @param[in]  x           Slot of the first variable
+   * @param[in]  sy          Sign of the second variable
+   * @param[in]  y           Slot of the second variable
+   * @param[in]  c           Bound of the sum
+   * @retval     bool        False if variables are in different packs,
+   *                         in which case state is not updated
+   */
+  bool constrain(int sx, unsigned int x, int sy, unsigned int y, long c)
+  {
+    if(!related(x, y)){ return false; }
+    if(!isBottom()){
+      update(pack(x)).constrain(sx, local(x), sy, local(y), c);
+      if(octagon(x).isEmpty()){ clear(); }
+    }
+    return true;
+  }
+
+
+  /** Variable is refined by the given bounds.
+   * State becomes bottom if the bounds are not satisfiable.
+   * @param[in]  var         Slot of the variable
+   * @param[in]  lower       Lower bound of the variable
+   * @param[in]  upper       Upper bound of the variable
+   */
+  void meet(unsigned int var, long lower, long upper)
+  {
+    if(isBottom()){ return; }
+    update(pack(var)).meet(local(var), lower, upper);
+    if(octagon(var).isEmpty()){ clear(); }
+  }
+
+
+  /** Bounds of a variable are provided.
+   * @param[in]  var         Slot of the variable
+   * @param[out] lower       Lower bound of the variable
+   * @param[out] upper       Upper bound of the variable
+   */
+  void bounds(unsigned int var, long &lower, long &upper) const
+  {
+    octagon(var).bounds(local(var), lower, upper);
+  }
+
+
+  /** Bounds of sx x + sy y are provided, for distinct variables.
+   * @param[in]  sx          Sign of the first variable
+   * @param[in]  x           Slot of the first variable
+   * @param[in]  sy          Sign of the second variable
+   * @param[in]  y           Slot of the second variable
+   * @param[out] lower       Lower bound of the sum
+   * @param[out] upper       Upper bound of the sum
+   * @retval     bool        False if variables are in different packs,
+   *                         in which case bounds are not provided
+   */
+  bool range(int sx, unsigned int x, int sy, unsigned int y,
+             long &lower, long &upper) const
+  {
+    if(!related(x, y)){ return false; }
+    octagon(x).range(sx, local(x), sy, local(y), lower, upper);
+    return true;
+  }
+
+
+  /** Every constraint on a variable is removed.
+   * @param[in]  var         Slot of the variable to be removed
+   */
+  void erase(unsigned int var)
+  {
+    if(!isBottom()){ update(pack(var)).forget(local(var)); }
+  }
+
+
+  /** State becomes the bottom state. */
+  void clear()
+  {
+    octagons.clear();
+  }
+
+
+  /** Predicate testing whether the state is the bottom state.
+   * @retval     bool        True if and only if control flow reaching
+   *                         the state is not feasible
+   */
+  bool isBottom() const
+  {
+    return octagons.empty();
+  }
+
+
+  /** A textual representation of the state is provided.
+   * Bounds of the variables are listed by slot, hence by name, as every
+   * other domain does, then the relations within each pack.
+   * @param[out] out         Output stream
+   */
+  void dump(ostream &out = cout) const;
+
+
+  /** Least upperbound with the given state is computed in place.
+   * @param[in]  other       State to be joined with the current one
+   */
+  void join(const AbstractState<Octagon> &other);
+
+
+  /** Widening is applied in place.
+   * @param[in]  previous    State reached by the previous iteration
+   */
+  void widen(const AbstractState<Octagon> &previous);
+
+
+  /** Every bound which changed since the previous state is removed.
+   * @param[in]  previous    State reached by the previous iteration
+   */
+  void saturate(const AbstractState<Octagon> &previous);
+
+
+  /** Fingerprint of the state is returned.
+   * @retval     size_t      Hash of the octagons
+   */
+  size_t fingerprint() const;
+
+
+  /** Packing of the variables is set.
+   * Packing must be set before any state is built, as it is shared by
+   * every state built for as many variables.
+   * @param[in]  packs       Pack of the variable in each slot, packs
+   *                         being numbered from 0
+   */
+  static void setPacks(const vector<unsigned int> &packs);
+
+
+  static unsigned long copies;      ///< Number of state copies performed
+  static unsigned long comparisons; ///< Number of full comparisons
+
+
+  private:
+  /** Type representing the packing of the variables. */
+  struct Layout{
+    vector<unsigned int>   pack;    ///< Pack of the variable in each slot
+    vector<unsigned int>   index;   ///< Index of each variable in its pack
+    vector<vector<string>> names;   ///< Name of the variables of each pack
+  };
+
+  static vector<unsigned int> packing;   ///< Packing set by setPacks()
+
+  shared_ptr<const Layout>    layout;    ///< Packing of the variables
+  vector<shared_ptr<Octagon>> octagons;  ///< Octagon of each pack, none
+                                         ///<  for the bottom state
+
+
+  /** Predicate testing whether two variables are in the same pack.
+   * @param[in]  x           Slot of the first variable
+   * @param[in]  y           Slot of the second variable
+   * @retval     bool        True if variables are in the same pack
+   */
+  bool related(unsigned int x, unsigned int y) const
+  {
+    return layout->pack[x] == layout->pack[y];
+  }
+
+
+  /** Pack of a variable.
+   * @param[in]  var         Slot of the variable
+   * @retval     unsigned int Index of the pack of the variable
+   */
+  unsigned int pack(unsigned int var) const
+  {
+    return layout->pack[var];
+  }
+
+
+  /** Index of a variable in its pack.
+   * @param[in]  var         Slot of the variable
+   * @retval     unsigned int Index of the variable in its octagon
+   */
+  unsigned int local(unsigned int var) const
+  {
+    return layout->index[var];
+  }
+
+
+  /** Octagon of the pack of a variable.
+   * @param[in]  var         Slot of the variable
+   * @retval     Octagon     Octagon relating the variable
+   */
+  const Octagon &octagon(unsigned int var) const
+  {
+    return *octagons[pack(var)];
+  }
+
+
+  /** Octagon of a pack is made private to the state before being
+   * updated.
+   * @param[in]  p           Index of the pack
+   * @retval     Octagon     Octagon which can be updated
+   */
+  Octagon &update(unsigned int p)
+  {
+    if(octagons[p].use_count() > 1){
+      octagons[p] = make_shared<Octagon>(*octagons[p]);
+    }
+    return *octagons[p];
+  }
+};
+#endif
@@ -0,0 +1,443 @@
+/** Powerset Modulo<N> abstract interpretation.
+ * Template handling the abstract iterpretation in the powerset
+ * Modulo<N> abstract domain.
+ *
+ * @file PModulo.hpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ * @ingroup domains
+ */
+#ifndef PMODULO_H
+#define PMODULO_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+/** Class representing the powerset Modulo<N> domain abstraction.
+ * Every value is identified by the set of the possible remainders of
+ * its integer division by N, so that the least upperbound of two
+ * remainders is not top. Remainders are always in [0, N), and the set
+ * is kept as a bitmask whose i-th bit is set if remainder i is
+ * possible: the empty set is bottom, the full set is top. Sums are
+ * computed by rotating the mask, products by a table of remainders
+ * built at compile time.
+ */
+template <int N = 2>
+class PModulo
+{
+  static_assert(N > 0 && N <= 64, "Remainders must fit in a 64 bit mask");
+
+  public:
+  /** 'Less than' operator overloading.
+   * Remainders carry no information about the order of the values.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not
+   *                         smaller than the second one
+   */
+  bool operator< (PModulo<N> other)
+  {
+    return mask != 0 && other.mask != 0;
+  }
+
+
+  /** 'Less than or equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not
+   *                         smaller than or equal to the second one
+   */
+  bool operator<=(PModulo<N> other)
+  {
+    return mask != 0 && other.mask != 0;
+  }
+
+
+  /** 'Equal to' operator overloading.
+   * Values may be equal only if they share a remainder.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not equal
+   *                         to the second one
+   */
+  bool operator==(PModulo<N> other)
+  {
+    return (mask & other.mask) != 0;
+  }
+
+
+  /** 'Greater than or equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure greater
+   *                         than or equal to the second one
+   */
+  bool operator>=(PModulo<N> other)
+  {
+    return mask != 0 && other.mask != 0;
+  }
+
+
+  /** 'Greater' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure greater
+   *                         than the second one
+   */
+  bool operator> (PModulo<N> other)
+  {
+    return mask != 0 && other.mask != 0;
+  }
+
+
+  /** 'Not equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not equal
+   *                         to the second one
+   */
+  bool operator!=(PModulo<N> other)
+  {
+    return mask != 0 && other.mask != 0;
+  }
+
+
+  /** Identity operator overloading.
+   * @retval     PModulo<N>  Identity of the value
+   */
+  PModulo<N> operator+()
+  {
+    return *this;
+  }
+
+
+  /** Opposite operator overloading.
+   * Remainder i becomes remainder N - i, modulo N.
+   * @retval     PModulo<N>  Opposite of the value
+   */
+  PModulo<N> operator-()
+  {
+    PModulo<N> opp;
+    uint64_t bits;
+
+    opp.mask = 0;
+    for(bits = mask; bits; bits &= bits - 1){
+      opp.mask |= bit(N - __builtin_ctzll(bits));
+    }
+
+    return opp;
+  }
+
+
+  /** Sum operator overloading.
+   * The other mask is rotated by every remainder of the current one.
+   * @param[in]  other       Right-operand
+   * @retval     PModulo<N>  Sum of the current and the given values
+   */
+  PModulo<N> operator+(PModulo<N> other)
+  {
+    PModulo<N> sum;
+    uint64_t bits = mask;
+
+    sum.mask = 0;
+    for(; bits && sum.mask != Full; bits &= bits - 1){
+      sum.mask |= rotate(other.mask, __builtin_ctzll(bits));
+    }
+
+    return sum;
+  }
+
+
+  /** Subtraction operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     PModulo<N>  Difference between the current and the
+   *                         given values
+   */
+  PModulo<N> operator-(PModulo<N> other)
+  {
+    return *this + (-other);
+  }
+
+
+  /** Multiplication operator overloading.
+   * Products of every pair of remainders are looked up in a table.
+   * @param[in]  other       Right-operand
+   * @retval     PModulo<N>  Product of the current and the given values
+   */
+  PModulo<N> operator*(PModulo<N> other)
+  {
+    PModulo<N> mul;
+    uint64_t a, b;
+
+    mul.mask = 0;
+    if(mask == 0 || other.mask == 0){ return mul; }
+    for(a = mask; a && mul.mask != Full; a &= a - 1){
+      for(b = other.mask; b; b &= b - 1){
+        mul.mask |= bit(products.table[__builtin_ctzll(a)]
+                                      [__builtin_ctzll(b)]);
+      }
+    }
+
+    return mul;
+  }
+
+
+  /** Integer division operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     PModulo<N>  Integer division between the current and
+   *                         the given values
+   */
+  PModulo<N> operator/(PModulo<N> other)
+  {
+    return unknown(other);
+  }
+
+
+  /** Remainder of the integer division operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     PModulo<N>  Remainder of the integer division between
+   *                         the current and the given value
+   */
+  PModulo<N> operator%(PModulo<N> other)
+  {
+    return unknown(other);
+  }
+
+
+  /** Power raising operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     PModulo<N>  Current value raised to the power of the
+   *                         given one
+   */
+  PModulo<N> operator^(PModulo<N> other)
+  {
+    return (mask == 0 || other.mask == 0) ? PModulo<N>() : top();
+  }
+
+
+  /** Cast to const char * operator overloading.
+   * This method is used to provide a textual representation of the
+   * value: bot, top, or the set of remainders.
+   * @retval     const char * Textual representation of the value
+   */
+  operator const char * ()
+  {
+    static thread_local char buff[4 * N + 3];
+    uint64_t bits = mask;
+    int length = 0;
+
+    if(mask == 0)   { return "bot"; }
+    if(mask == Full){ return "top"; }
+
+    // Text is kept in a per-thread buffer, which outlives the call.
+    buff[length++] = '{';
+    for(; bits; bits &= bits - 1){
+      length += snprintf(buff + length, sizeof(buff) - length, "%s%d",
+                         (length > 1) ? ", " : "", __builtin_ctzll(bits));
+    }
+    buff[length++] = '}';
+    buff[length]   = '\0';
+
+    return buff;
+  }
+
+
+  /** Predicate testing whether two values are equal.
+   * @param[in]  a           First operand
+   * @param[in]  b           Second operand
+   * @retval     bool        True if and only if values are precisely
+   *                         equal
+   */
+  static bool equal(PModulo<N> a, PModulo<N> b)
+  {
+    return a.mask == b.mask;
+  }
+
+
+  /** Hash function.
+   * Values which are equal, according to equal(), have the same hash.
+   * @param[in]  a           Abstract value
+   * @retval     size_t      Hash of the value
+   */
+  static size_t hash(PModulo<N> a)
+  {
+    return (size_t) a.mask;
+  }
+
+
+  /** Least upperbound between two values in the abstract domain is
+   * computed.
+   * @param[in]  a           First abstract value
+   * @param[in]  b           Second abstract value
+   * @retval     PModulo<N>  Least upperbound of a and b
+   */
+  static PModulo<N> lub(PModulo<N> a, PModulo<N> b)
+  {
+    PModulo<N> lub;
+    lub.mask = a.mask | b.mask;
+    return lub;
+  }
+
+
+  /** Widening operator.
+   * Domain has finite height, hence no actual widening is used.
+   * @param[in]  a           Previous value
+   * @param[in]  b           Current value
+   * @retval     PModulo<N>  Widened value
+   */
+  static PModulo<N> nabla(PModulo<N> a, PModulo<N> b)
+  {
+    (void) a;
+    return b;
+  }
+
+
+  /** Abstraction function.
+   * For the particular case when given set is a singleton.
+   * @param[in]  value       Value of the concrete domain
+   * @retval     PModulo<N>  Abstract value corresponding to the
+   *                         given concrete value
+   */
+  static PModulo<N> alpha(int value)
+  {
+    PModulo<N> a;
+    a.mask = bit(residue(value));
+    return a;
+  }
+
+
+  /** Abstraction function.
+   * @param[in]  values      Subset of the concrete domain
+   * @retval     PModulo<N>  Abstract value corresponding to the least
+   *                         upperbound of the concrete values
+   */
+  static PModulo<N> alpha(vector<int> values)
+  {
+    vector<int>::iterator it;
+    PModulo<N> a;
+
+    a.mask = 0;
+    for(it = values.begin(); it != values.end(); ++it){
+      a.mask |= bit(residue(*it));
+    }
+
+    return a;
+  }
+
+
+  /** Constant method returning an instance of the "I don't know" value.
+   * @retval     PModulo<N>  Value representing no information
+   */
+  static PModulo<N> top()
+  {
+    PModulo<N> top;
+    top.mask = Full;
+    return top;
+  }
+
+
+  /** Bounds of the concrete values are provided.
+   * This method is used by reduced products to exchange information
+   * between domains. Remainders do not bound the concrete values, so
+   * only bottom is reported, as an empty range.
+   * @param[out] lower       Lower bound of the concrete values
+   * @param[out] upper       Upper bound of the concrete values
+   */
+  void bounds(long &lower, long &upper)
+  {
+    lower = (mask == 0) ? 1L : numeric_limits<long>::min();
+    upper = (mask == 0) ? 0L : numeric_limits<long>::max();
+  }
+
+
+  /** Value is refined by the given bounds.
+   * This method is used by reduced products to exchange information
+   * between domains. If the range is shorter than N, only the
+   * remainders of its values are kept.
+   * @param[in]  lower       Lower bound of the concrete values
+   * @param[in]  upper       Upper bound of the concrete values
+   */
+  void meet(long lower, long upper)
+  {
+    uint64_t range, width;
+
+    if(lower > upper){ mask = 0; return; }
+
+    // Width is computed unsigned, since wide ranges overflow long.
+    width = (uint64_t) upper - (uint64_t) lower;
+    if(lower == numeric_limits<long>::min()
+    || upper == numeric_limits<long>::max()
+    || width >= N){
+      return;
+    }
+
+    // Remainders of the range are a run of bits starting at lower.
+    range = (width == N - 1) ? Full
+          : rotate(bit(width + 1) - 1, residue(lower));
+    mask &= range;
+  }
+
+
+  private:
+  /** Mask of the top value, where every remainder is possible. */
+  static constexpr uint64_t Full = (N == 64) ? ~0ULL : (1ULL << N) - 1;
+
+
+  /** Type representing the table of products of remainders. */
+  struct Table{
+    unsigned char table[N][N];   ///< Remainder of each product
+
+    /** Table is filled at compile time. */
+    constexpr Table() : table()
+    {
+      for(int a = 0; a < N; ++a){
+        for(int b = 0; b < N; ++b){ table[a][b] = (a * b) % N; }
+      }
+    }
+  };
+  static constexpr Table products = Table();   ///< Products of remainders
+
+
+  uint64_t mask;   ///< Set of the possible remainders
+
+
+  /** Mask with the given remainder only.
+   * @param[in]  r           Remainder, in [0, N]
+   * @retval     uint64_t    Mask with the bit of r modulo N set
+   */
+  static uint64_t bit(int r)
+  {
+    return 1ULL << (r % N);
+  }
+
+
+  /** Remainder of a concrete value, always in [0, N).
+   * @param[in]  value       Value of the concrete domain
+   * @retval     int         Remainder of value
+   */
+  static int residue(long value)
+  {
+    return (int) (((value % N) + N) % N);
+  }
+
+
+  /** Every remainder of a mask is increased by r, modulo N.
+   * @param[in]  bits        Mask of remainders
+   * @param[in]  r           Remainder to be added, in [0, N)
+   * @retval     uint64_t    Rotated mask
+   */
+  static uint64_t rotate(uint64_t bits, int r)
+  {
+    return (r == 0) ? bits : ((bits << r) | (bits >> (N - r))) & Full;
+  }
+
+
+  /** Result of an operation whose remainder is unknown.
+   * Remainder 0 does not mean that a divisor is zero, hence the result
+   * is bottom only if an operand is bottom.
+   * @param[in]  other       Right-operand
+   * @retval     PModulo<N>  Bottom or top
+   */
+  PModulo<N> unknown(PModulo<N> other)
+  {
+    return (mask == 0 || other.mask == 0) ? PModulo<N>() : top();
+  }
+};
+#endif
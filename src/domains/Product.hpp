@@ -0,0 +1,425 @@
+/** Reduced product abstract interpretation.
+ * Template handling the abstract interpretation in the reduced product
+ * of other abstract domains.
+ *
+ * @file Product.hpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ * @ingroup domains
+ */
+#ifndef PRODUCT_HPP
+#define PRODUCT_HPP
+
+#include <stdio.h>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/** Class representing the reduced product of abstract domains.
+ * Every value is a tuple holding one value for each component domain,
+ * so that a single traversal of the program, with a single fixpoint per
+ * loop, computes the result of every component. After each operation
+ * components exchange the bounds of their concrete values, so that each
+ * one is refined by the others. Every component must provide the
+ * bounds() and meet() methods.
+ */
+template <typename... Ds>
+class Product
+{
+  public:
+  /** 'Less than' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not
+   *                         smaller than the second one
+   */
+  bool operator< (Product<Ds...> other)
+  {
+    return all(other, [](auto a, auto b){ return a <  b; });
+  }
+
+
+  /** 'Less than or equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not
+   *                         smaller than or equal to the second one
+   */
+  bool operator<=(Product<Ds...> other)
+  {
+    return all(other, [](auto a, auto b){ return a <= b; });
+  }
+
+
+  /** 'Equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not equal
+   *                         to the second one
+   */
+  bool operator==(Product<Ds...> other)
+  {
+    return all(other, [](auto a, auto b){ return a == b; });
+  }
+
+
+  /** 'Greater than or equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure greater
+   *                         than or equal to the second one
+   */
+  bool operator>=(Product<Ds...> other)
+  {
+    return all(other, [](auto a, auto b){ return a >= b; });
+  }
+
+
+  /** 'Greater' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure greater
+   *                         than the second one
+   */
+  bool operator> (Product<Ds...> other)
+  {
+    return all(other, [](auto a, auto b){ return a >  b; });
+  }
+
+
+  /** 'Not equal to' operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     bool        False if left-operand is for sure not equal
+   *                         to the second one
+   */
+  bool operator!=(Product<Ds...> other)
+  {
+    return all(other, [](auto a, auto b){ return a != b; });
+  }
+
+
+  /** Identity operator overloading.
+   * @retval     Product     Identity of the value
+   */
+  Product<Ds...> operator+()
+  {
+    return map(*this, *this, [](auto a, auto b){ (void) b; return +a; });
+  }
+
+
+  /** Opposite operator overloading.
+   * @retval     Product     Opposite of the value
+   */
+  Product<Ds...> operator-()
+  {
+    return map(*this, *this, [](auto a, auto b){ (void) b; return -a; });
+  }
+
+
+  /** Sum operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Product     Sum of the current and the given values
+   */
+  Product<Ds...> operator+(Product<Ds...> other)
+  {
+    return map(*this, other, [](auto a, auto b){ return a + b; });
+  }
+
+
+  /** Subtraction operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Product     Difference between the current and the
+   *                         given values
+   */
+  Product<Ds...> operator-(Product<Ds...> other)
+  {
+    return map(*this, other, [](auto a, auto b){ return a - b; });
+  }
+
+
+  /** Multiplication operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Product     Product of the current and the given values
+   */
+  Product<Ds...> operator*(Product<Ds...> other)
+  {
+    return map(*this, other, [](auto a, auto b){ return a * b; });
+  }
+
+
+  /** Integer division operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Product     Integer division between the current and
+   *                         the given values
+   */
+  Product<Ds...> operator/(Product<Ds...> other)
+  {
+    return map(*this, other, [](auto a, auto b){ return a / b; });
+  }
+
+
+  /** Remainder of the integer division operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Product     Remainder of the integer division between
+   *                         the current and the given value
+   */
+  Product<Ds...> operator%(Product<Ds...> other)
+  {
+    return map(*this, other, [](auto a, auto b){ return a % b; });
+  }
+
+
+  /** Power raising operator overloading.
+   * @param[in]  other       Right-operand
+   * @retval     Product     Current value raised to the power of the
+   *                         given one
+   */
+  Product<Ds...> operator^(Product<Ds...> other)
+  {
+    return map(*this, other, [](auto a, auto b){ return a ^ b; });
+  }
+
+
+  /** Cast to const char * operator overloading.
+   * This method is used to provide a textual representation of the
+   * value, as the tuple of the representations of the components.
+   * @retval     const char * Textual representation of the value
+   */
+  operator const char * ()
+  {
+    static thread_local char text[256];
+    string tuple = "(";
+
+    apply([&tuple](auto &... d){
+      ((tuple += (const char *) d, tuple += ", "), ...);
+    }, components);
+    tuple.replace(tuple.size() - 2, 2, ")");
+
+    // Text is kept in a per-thread buffer, which outlives the call.
+    snprintf(text, sizeof(text), "%s", tuple.c_str());
+    return text;
+  }
+
+
+  /** Predicate testing whether two values are equal.
+   * @param[in]  a           First operand
+   * @param[in]  b           Second operand
+   * @retval     bool        True if and only if every component is
+   *                         precisely equal
+   */
+  static bool equal(Product<Ds...> a, Product<Ds...> b)
+  {
+    return a.all(b, [](auto x, auto y){ return decltype(x)::equal(x, y); });
+  }
+
+
+  /** Hash function.
+   * Values which are equal, according to equal(), have the same hash.
+   * @param[in]  a           Abstract value
+   * @retval     size_t      Hash of the value
+   */
+  static size_t hash(Product<Ds...> a)
+  {
+    size_t h = 0;
+
+    apply([&h](auto &... d){
+      ((h ^= remove_reference_t<decltype(d)>::hash(d) + 0x9E3779B9
+           + (h << 6) + (h >> 2)), ...);
+    }, a.components);
+    return h;
+  }
+
+
+  /** Least upperbound between two values in the abstract domain is
+   * computed.
+   * @param[in]  a           First abstract value
+   * @param[in]  b           Second abstract value
+   * @retval     Product     Least upperbound of a and b
+   */
+  static Product<Ds...> lub(Product<Ds...> a, Product<Ds...> b)
+  {
+    return map(a, b, [](auto x, auto y){ return decltype(x)::lub(x, y); });
+  }
+
+
+  /** Widening operator.
+   * Widening is applied to every component. Result is not reduced, so
+   * that termination of the components' widenings is preserved: each of
+   * them keeps the previous value where it is stable, hence reductions
+   * of the following iterations cannot make it shrink back.
+   * @param[in]  a           Previous value
+   * @param[in]  b           Current value
+   * @retval     Product     Widened value
+   */
+  static Product<Ds...> nabla(Product<Ds...> a, Product<Ds...> b)
+  {
+    return map(a, b, [](auto x, auto y){ return decltype(x)::nabla(x, y); },
+               false);
+  }
+
+
+  /** Abstraction function.
+   * For the particular case when given set is a singleton.
+   * @param[in]  value       Value of the concrete domain
+   * @retval     Product     Abstract value corresponding to the
+   *                         given concrete value
+   */
+  static Product<Ds...> alpha(int value)
+  {
+    Product<Ds...> a;
+
+    a.components = make_tuple(Ds::alpha(value)...);
+    return a;
+  }
+
+
+  /** Abstraction function.
+   * @param[in]  values      Subset of the concrete domain
+   * @retval     Product     Abstract value corresponding to the least
+   *                         upperbound of the concrete values
+   */
+  static Product<Ds...> alpha(vector<int> values)
+  {
+    Product<Ds...> a;
+
+    a.components = make_tuple(Ds::alpha(values)...);
+    a.reduce();
+    return a;
+  }
+
+
+  /** Constant method returning an instance of the "I don't know" value.
+   * @retval     Product     Value representing no information
+   */
+  static Product<Ds...> top()
+  {
+    Product<Ds...> top;
+
+    top.components = make_tuple(Ds::top()...);
+    return top;
+  }
+
+
+  /** Bounds of the concrete values are provided.
+   * Bounds are the intersection of the bounds of the components.
+   * @param[out] lower       Lower bound of the concrete values
+   * @param[out] upper       Upper bound of the concrete values
+   */
+  void bounds(long &lower, long &upper)
+  {
+    lower = numeric_limits<long>::min();
+    upper = numeric_limits<long>::max();
+
+    apply([&lower, &upper](auto &... d){
+      (intersect(d, lower, upper), ...);
+    }, components);
+  }
+
+
+  /** Value is refined by the given bounds.
+   * Every component is refined.
+   * @param[in]  lower       Lower bound of the concrete values
+   * @param[in]  upper       Upper bound of the concrete values
+   */
+  void meet(long lower, long upper)
+  {
+    apply([lower, upper](auto &... d){
+      (d.meet(lower, upper), ...);
+    }, components);
+  }
+
+
+  private:
+  tuple<Ds...> components;   ///< Value of each component domain
+
+
+  /** Reduction step.
+   * Bounds known by any component are given to every other component.
+   */
+  void reduce()
+  {
+    long lower, upper;
+
+    bounds(lower, upper);
+    meet(lower, upper);
+  }
+
+
+  /** Given range is intersected with the bounds of a component.
+   * @param[in]  d           Component value
+   * @param[in,out] lower    Lower bound of the range
+   * @param[in,out] upper    Upper bound of the range
+   */
+  template <typename D>
+  static void intersect(D &d, long &lower, long &upper)
+  {
+    long l, u;
+
+    d.bounds(l, u);
+    if(l > lower){ lower = l; }
+    if(u < upper){ upper = u; }
+  }
+
+
+  /** Predicate is tested on every pair of components.
+   * @param[in]  other       Right-operand
+   * @param[in]  predicate   Predicate on a pair of components
+   * @retval     bool        True if and only if the predicate holds for
+   *                         every pair of components
+   */
+  template <typename F>
+  bool all(Product<Ds...> &other, F predicate)
+  {
+    return all(other, predicate, index_sequence_for<Ds...>());
+  }
+
+
+  /** Predicate is tested on every pair of components.
+   * @param[in]  other       Right-operand
+   * @param[in]  predicate   Predicate on a pair of components
+   * @retval     bool        True if and only if the predicate holds for
+   *                         every pair of components
+   */
+  template <typename F, size_t... I>
+  bool all(Product<Ds...> &other, F predicate, index_sequence<I...>)
+  {
+    return (predicate(get<I>(components), get<I>(other.components)) && ...);
+  }
+
+
+  /** Operation is applied to every pair of components.
+   * @param[in]  a           First operand
+   * @param[in]  b           Second operand
+   * @param[in]  operation   Operation on a pair of components
+   * @param[in]  reduced     True if the result shall be reduced
+   * @retval     Product     Result of the operation
+   */
+  template <typename F>
+  static Product<Ds...> map(Product<Ds...> &a, Product<Ds...> &b,
+                            F operation, bool reduced = true)
+  {
+    return map(a, b, operation, reduced, index_sequence_for<Ds...>());
+  }
+
+
+  /** Operation is applied to every pair of components.
+   * @param[in]  a           First operand
+   * @param[in]  b           Second operand
+   * @param[in]  operation   Operation on a pair of components
+   * @param[in]  reduced     True if the result shall be reduced
+   * @retval     Product     Result of the operation
+   */
+  template <typename F, size_t... I>
+  static Product<Ds...> map(Product<Ds...> &a, Product<Ds...> &b,
+                            F operation, bool reduced, index_sequence<I...>)
+  {
+    Product<Ds...> result;
+
+    result.components = make_tuple(
+      operation(get<I>(a.components), get<I>(b.components))...
+    );
+    if(reduced){ result.reduce(); }
+
+    return result;
+  }
+};
+#endif
@@ -7,10 +7,12 @@
  * @ingroup domains
  */
 #include <malloc.h>
+#include <algorithm>
 #include <iostream>
 #include <limits>
 
 #include "SInterval.hpp"
+#include "Thresholds.hpp"
 
 
 /** 'Less than' operator overloading.
@@ -31,7 +33,7 @@ bool SInterval::operator< (SInterval other)
  */
 bool SInterval::operator<=(SInterval other)
 {
-  return (center - offset >= other.center + other.offset) && !bottom;
+  return (center - offset <= other.center + other.offset) && !bottom;
 }
 
 
@@ -77,7 +79,7 @@ bool SInterval::operator> (SInterval other)
  */
 bool SInterval::operator!=(SInterval other)
 {
-  return (center != other.center || offset != other.offset || offset == 0)
+  return (center != other.center || offset != 0 || other.offset != 0)
       && !bottom;
 }
 
@@ -101,6 +103,7 @@ SInterval SInterval::operator-()
   opp.center = -center;
   opp.offset = offset;
   opp.bottom = bottom;
+  opp.clamp();
   
   return opp;
 }
@@ -117,6 +120,7 @@ SInterval SInterval::operator+(SInterval other)
   sum.center = center + other.center;
   sum.offset = offset + other.offset;
   sum.bottom = bottom || other.bottom;
+  sum.clamp();
   
   return sum;
 }
@@ -132,33 +136,49 @@ SInterval SInterval::operator-(SInterval other)
   SInterval sub;
   
   sub.center = center - other.center;
-  sub.offset = offset - other.offset;
-  if(sub.offset < 0){
-    sub.offset = -sub.offset;
-  }
+  sub.offset = offset + other.offset;
   sub.bottom = bottom || other.bottom;
+  sub.clamp();
   
   return sub;
 }
 
 
 /** Multiplication operator overloading.
+ * Product ranges between the products of the bounds, and is enclosed
+ * into a symmetric interval.
  * @param[in]  other       Right-operand
  * @retval     SInterval   Product of the current and the given values
  */
 SInterval SInterval::operator*(SInterval other)
 {
   SInterval mul;
+  long l = center - offset, u = center + offset;
+  long ol = other.center - other.offset, ou = other.center + other.offset;
+  long corners[4];
   
-  mul.center = center * other.center;
-  mul.offset = offset * other.offset;
   mul.bottom = bottom || other.bottom;
+  if(mul.bottom){ return mul; }
+  if((center == 0 && offset == 0) || (other.center == 0 && other.offset == 0)){
+    return alpha(0);
+  }
+  if(offset >= numeric_limits<short>::max()
+  || other.offset >= numeric_limits<short>::max()
+  || __builtin_mul_overflow(l, ol, &corners[0])
+  || __builtin_mul_overflow(l, ou, &corners[1])
+  || __builtin_mul_overflow(u, ol, &corners[2])
+  || __builtin_mul_overflow(u, ou, &corners[3])){
+    return top();
+  }
   
-  return mul;
+  return enclose(*min_element(corners, corners + 4),
+                 *max_element(corners, corners + 4));
 }
 
 
 /** Integer division operator overloading.
+ * Divisor which does not contain zero gives a quotient ranging between
+ * the quotients of the bounds, any other one gives top.
  * @param[in]  other       Right-operand
  * @retval     SInterval   Integer division between the current and
  *                         the given values
@@ -166,17 +186,26 @@ SInterval SInterval::operator*(SInterval other)
 SInterval SInterval::operator/(SInterval other)
 {
   SInterval div;
+  long l = center - offset, u = center + offset;
+  long ol = other.center - other.offset, ou = other.center + other.offset;
+  long corners[4];
   
   if(other.center == 0 && other.offset == 0){
     div.bottom = true;
   }
-  else if(other.center == 0 || other.offset == 0){
+  else if(bottom || other.bottom){
+    div.bottom = true;
+  }
+  else if(offset >= numeric_limits<short>::max() || (ol <= 0 && ou >= 0)){
     div = top();
   }
   else{
-    div.center = center / other.center;
-    div.offset = offset / other.offset;
-    div.bottom = bottom || other.bottom;
+    corners[0] = l / ol;
+    corners[1] = l / ou;
+    corners[2] = u / ol;
+    corners[3] = u / ou;
+    div = enclose(*min_element(corners, corners + 4),
+                  *max_element(corners, corners + 4));
   }
   
   return div;
@@ -228,7 +257,8 @@ SInterval SInterval::operator^(SInterval other)
  */
 SInterval::operator const char * ()
 {
-  char c[16], off[16];
+  static thread_local char text[48];
+  char c[24], off[24];
   
   sprintf(c,  "%ld", center);
   sprintf(off, "%ld", offset);
@@ -239,7 +269,9 @@ SInterval::operator const char * ()
   + (offset == numeric_limits<short>::max() ? "inf" : off)
   ;
   
-  return a.c_str();
+  // Text is kept in a per-thread buffer, which outlives the call.
+  snprintf(text, sizeof(text), "%s", a.c_str());
+  return text;
 }
 
   
@@ -251,8 +283,25 @@ SInterval::operator const char * ()
  */
 bool SInterval::equal(SInterval a, SInterval b)
 {
-  return a.center == b.center && a.offset == b.offset
-      && a.bottom == b.bottom;
+  // Center and offset of bottom are meaningless, so every bottom is
+  // the same.
+  if(a.bottom || b.bottom){ return a.bottom && b.bottom; }
+  return a.center == b.center && a.offset == b.offset;
+}
+
+
+/** Hash function.
+ * Values which are equal, according to equal(), have the same hash.
+ * @param[in]  a           Abstract value
+ * @retval     size_t      Hash of the value
+ */
+size_t SInterval::hash(SInterval a)
+{
+  size_t h = (size_t) a.center;
+  
+  if(a.bottom){ return 0; }
+  h ^= (size_t) a.offset + 0x9E3779B9 + (h << 6) + (h >> 2);
+  return h;
 }
 
 
@@ -265,15 +314,25 @@ bool SInterval::equal(SInterval a, SInterval b)
 SInterval SInterval::lub(SInterval a, SInterval b)
 {
   SInterval lub;
+  long bound;
   
   if(a.bottom) lub = b;
   else if(b.bottom) lub = a;
   else{
+    // Offset must reach the farthest bound of both values, also when
+    // the center has been rounded.
     lub.center = (a.center + b.center) / 2;
-    lub.offset = (a.center > b.center
-                  ? a.center - lub.center : b.center - lub.center)
-               + (a.offset > b.offset ? a.offset : b.offset);
+    lub.offset = 0L;
+    bound = lub.center - (a.center - a.offset);
+    if(bound > lub.offset){ lub.offset = bound; }
+    bound = (a.center + a.offset) - lub.center;
+    if(bound > lub.offset){ lub.offset = bound; }
+    bound = lub.center - (b.center - b.offset);
+    if(bound > lub.offset){ lub.offset = bound; }
+    bound = (b.center + b.offset) - lub.center;
+    if(bound > lub.offset){ lub.offset = bound; }
     lub.bottom = false;
+    lub.clamp();
   }
   
   return lub;
@@ -281,6 +340,10 @@ SInterval SInterval::lub(SInterval a, SInterval b)
 
 
 /** Widening operator.
+ * Offset which grows is widened to the nearest threshold, see
+ * Thresholds, or to infinity if there is none. Result never shrinks:
+ * previous value is kept if it includes the current one, and it is
+ * joined to the current one if a reduction narrowed the latter.
  * @param[in]  a           Previous value
  * @param[in]  b           Current value
  * @retval     SInterval   Widened value
@@ -289,11 +352,23 @@ SInterval SInterval::nabla(SInterval a, SInterval b)
 {
   SInterval widened;
   
+  if(a.bottom){ return b; }
+  if(b.bottom){ return a; }
+  if(b.center - b.offset >= a.center - a.offset
+  && b.center + b.offset <= a.center + a.offset){
+    return a;
+  }
+  if(b.center - b.offset > a.center - a.offset
+  || b.center + b.offset < a.center + a.offset){
+    b = lub(a, b);
+  }
+  
   widened.center = b.center;
-  widened.offset = (b.offset > a.offset && b.center >= a.center)
-                 ? numeric_limits<short>::max()
+  widened.offset = (b.offset > a.offset)
+                 ? Thresholds::above(b.offset)
                  : b.offset;
-  widened.bottom = b.bottom;
+  widened.bottom = false;
+  widened.clamp();
   
   return widened;
 }
@@ -349,3 +424,100 @@ SInterval SInterval::top()
   
   return top;
 }
+
+
+/** Bounds of the concrete values are provided.
+ * This method is used by reduced products to exchange information
+ * between domains. Missing bounds are represented by the limits of
+ * long, bottom is represented by an empty range.
+ * @param[out] lower       Lower bound of the concrete values
+ * @param[out] upper       Upper bound of the concrete values
+ */
+void SInterval::bounds(long &lower, long &upper)
+{
+  if(bottom){
+    lower = 1L;
+    upper = 0L;
+  }
+  else if(offset >= numeric_limits<short>::max()){
+    lower = numeric_limits<long>::min();
+    upper = numeric_limits<long>::max();
+  }
+  else{
+    lower = center - offset;
+    upper = center + offset;
+  }
+}
+
+
+/** Value is refined by the given bounds.
+ * This method is used by reduced products to exchange information
+ * between domains. Value becomes bottom if the range is empty.
+ * @param[in]  lower       Lower bound of the concrete values
+ * @param[in]  upper       Upper bound of the concrete values
+ */
+void SInterval::meet(long lower, long upper)
+{
+  long l, u, c, o;
+  
+  if(bottom){ return; }
+  
+  if(lower > upper){
+    bottom = true;
+    return;
+  }
+  
+  // Intersection is computed, then it is enclosed into a symmetric
+  // interval. Value is only replaced if it gets narrower.
+  bounds(l, u);
+  if(lower > l){ l = lower; }
+  if(upper < u){ u = upper; }
+  if(l > u){
+    bottom = true;
+    return;
+  }
+  if(l == numeric_limits<long>::min() || u == numeric_limits<long>::max()){
+    return;
+  }
+  
+  c = l + (u - l) / 2;
+  o = (c - l > u - c) ? c - l : u - c;
+  if(o < offset){
+    center = c;
+    offset = o;
+  }
+}
+
+
+/** Symmetric interval enclosing the given range is built.
+ * @param[in]  lower       Lower bound of the range
+ * @param[in]  upper       Upper bound of the range
+ * @retval     SInterval   Narrowest symmetric interval including the
+ *                         range
+ */
+SInterval SInterval::enclose(long lower, long upper)
+{
+  SInterval a;
+  
+  a.center = lower + (upper - lower) / 2;
+  a.offset = (a.center - lower > upper - a.center) ? a.center - lower
+                                                   : upper - a.center;
+  a.bottom = false;
+  a.clamp();
+  
+  return a;
+}
+
+
+/** Offset is brought back within the limit of short.
+ * Such limit represents infinity, hence infinity is absorbing and every
+ * infinite value has the same center, so that it is the top value
+ * whatever operation produced it.
+ */
+void SInterval::clamp()
+{
+  if(offset >= numeric_limits<short>::max()){
+    center = 0L;
+    offset = numeric_limits<short>::max();
+  }
+}
@@ -99,6 +99,8 @@ class SInterval
 
 
   /** Multiplication operator overloading.
+   * Product ranges between the products of the bounds, and is enclosed
+   * into a symmetric interval.
    * @param[in]  other       Right-operand
    * @retval     SInterval    Product of the current and the given values
    */
@@ -106,6 +108,8 @@ class SInterval
 
 
   /** Integer division operator overloading.
+   * Divisor which does not contain zero gives a quotient ranging between
+   * the quotients of the bounds, any other one gives top.
    * @param[in]  other       Right-operand
    * @retval     SInterval    Integer division between the current and
    *                         the given values
@@ -146,6 +150,14 @@ class SInterval
   static bool equal(SInterval a, SInterval b);
   
   
+  /** Hash function.
+   * Values which are equal, according to equal(), have the same hash.
+   * @param[in]  a           Abstract value
+   * @retval     size_t      Hash of the value
+   */
+  static size_t hash(SInterval a);
+  
+  
   /** Least upperbound between two values in the abstract domain is
    * computed.
    * @param[in]  a           First abstract value
@@ -156,7 +168,10 @@ class SInterval
   
   
   /** Widening operator.
-   * No actual widening is used in the SInterval domain.
+   * Offset which grows is widened to the nearest threshold, see
+   * Thresholds, or to infinity if there is none. Result never shrinks:
+   * previous value is kept if it includes the current one, and it is
+   * joined to the current one if a reduction narrowed the latter.
    * @param[in]  a           Previous value
    * @param[in]  b           Current value
    * @retval     SInterval    Widened value
@@ -187,9 +202,45 @@ class SInterval
   static SInterval top();
   
   
+  /** Bounds of the concrete values are provided.
+   * This method is used by reduced products to exchange information
+   * between domains. Missing bounds are represented by the limits of
+   * long, bottom is represented by an empty range.
+   * @param[out] lower       Lower bound of the concrete values
+   * @param[out] upper       Upper bound of the concrete values
+   */
+  void bounds(long &lower, long &upper);
+  
+  
+  /** Value is refined by the given bounds.
+   * This method is used by reduced products to exchange information
+   * between domains. Value becomes bottom if the range is empty.
+   * @param[in]  lower       Lower bound of the concrete values
+   * @param[in]  upper       Upper bound of the concrete values
+   */
+  void meet(long lower, long upper);
+  
+  
   private:
   long center;          ///< Central point of the symmetric interval
   long offset;          ///< Offset
   bool bottom;          ///< True if the value is bottom
+  
+  
+  /** Symmetric interval enclosing the given range is built.
+   * @param[in]  lower       Lower bound of the range
+   * @param[in]  upper       Upper bound of the range
+   * @retval     SInterval   Narrowest symmetric interval including the
+   *                         range
+   */
+  static SInterval enclose(long lower, long upper);
+  
+  
+  /** Offset is brought back within the limit of short.
+   * Such limit represents infinity, hence infinity is absorbing and
+   * every infinite value has the same center, so that it is the top
+   * value whatever operation produced it.
+   */
+  void clamp();
 };
 #endif
@@ -6,6 +6,8 @@
  * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
  * @ingroup domains
  */
+#include <limits>
+
 #include "Sign.hpp"
 
 
@@ -16,15 +18,7 @@
  */
 bool Sign::operator< (Sign other)
 {
-  bool table[] = {
-    false, false, false, false, false,
-    false, true,  true,  true,  true,
-    false, false, false, true,  true,
-    false, false, false, true,  true,
-    false, true,  true,  true,  true
-  };
-  
-  return table[value * 5 + other.value];
+  return lesser[value][other.value];
 }
 
 
@@ -35,15 +29,7 @@ bool Sign::operator< (Sign other)
  */
 bool Sign::operator<=(Sign other)
 {
-  bool table[] = {
-    false, false, false, false, false,
-    false, true,  true,  true,  true,
-    false, false, true,  true,  true,
-    false, false, false, true,  true,
-    false, true,  true,  true,  true
-  };
-  
-  return table[value * 5 + other.value];
+  return lesserEqual[value][other.value];
 }
 
 
@@ -54,15 +40,7 @@ bool Sign::operator<=(Sign other)
  */
 bool Sign::operator==(Sign other)
 {
-  bool table[] = {
-    false, false, false, false, false,
-    false, true,  false, false, true,
-    false, false, true,  false, true,
-    false, false, false, true,  true,
-    false, true,  true,  true,  true
-  };
-  
-  return table[value * 5 + other.value];
+  return equalTo[value][other.value];
 }
 
 
@@ -95,8 +73,7 @@ bool Sign::operator> (Sign other)
  */
 bool Sign::operator!=(Sign other)
 {
-  return !(value == BOT || other.value == BOT ||
-          (value == ZERO && other.value == ZERO));
+  return notEqualTo[value][other.value];
 }
 
 
@@ -115,9 +92,8 @@ Sign Sign::operator+()
 Sign Sign::operator-()
 {
   Sign opp;
-  signType table[] = {BOT, PLUS, ZERO, MINUS, TOP};
   
-  opp.value = table[value];
+  opp.value = opposites[value];
   
   return opp;
 }
@@ -130,15 +106,8 @@ Sign Sign::operator-()
 Sign Sign::operator+(Sign other)
 {
   Sign sum;
-  signType table[] = {
-    BOT,   BOT,   BOT,   BOT,   BOT,
-    BOT,   MINUS, MINUS, TOP,   TOP,
-    BOT,   MINUS, ZERO,  PLUS,  TOP,
-    BOT,   TOP,   PLUS,  PLUS,  TOP,
-    BOT,   TOP,   TOP,   TOP,   TOP
-  };
   
-  sum.value = table[value * 5 + other.value];
+  sum.value = sums[value][other.value];
   
   return sum;
 }
@@ -152,15 +121,8 @@ Sign Sign::operator+(Sign other)
 Sign Sign::operator-(Sign other)
 {
   Sign sub;
-  signType table[] = {
-    BOT,  BOT,   BOT,   BOT,   BOT,
-    BOT,  TOP,   MINUS, MINUS, TOP,
-    BOT,  PLUS,  ZERO,  MINUS, TOP,
-    BOT,  PLUS,  PLUS,  TOP,   TOP,
-    BOT,  TOP,   TOP,   TOP,   TOP
-  };
   
-  sub.value = table[value * 5 + other.value];
+  sub.value = differences[value][other.value];
   
   return sub;
 }
@@ -173,15 +135,8 @@ Sign Sign::operator-(Sign other)
 Sign Sign::operator*(Sign other)
 {
   Sign mul;
-  signType table[] = {
-    BOT,   BOT,   BOT,   BOT,   BOT,
-    BOT,   PLUS,  ZERO,  MINUS, TOP,
-    BOT,   ZERO,  ZERO,  ZERO,  ZERO,
-    BOT,   MINUS, ZERO,  PLUS,  TOP,
-    BOT,   TOP,   ZERO,  TOP,   TOP
-  };
   
-  mul.value = table[value * 5 + other.value];
+  mul.value = products[value][other.value];
   
   return mul;
 }
@@ -195,15 +150,8 @@ Sign Sign::operator*(Sign other)
 Sign Sign::operator/(Sign other)
 {
   Sign div;
-  signType table[] = {
-    BOT,   BOT,   BOT,   BOT,   BOT,
-    BOT,   TOP,   BOT,   TOP,   TOP,
-    BOT,   ZERO,  BOT,   ZERO,  ZERO,
-    BOT,   TOP,   BOT,   TOP,   TOP,
-    BOT,   TOP,   BOT,   TOP,   TOP
-  };
   
-  div.value = table[value * 5 + other.value];
+  div.value = quotients[value][other.value];
   
   return div;
 }
@@ -217,15 +165,8 @@ Sign Sign::operator/(Sign other)
 Sign Sign::operator%(Sign other)
 {
   Sign rem;
-  signType table[] = {
-    BOT,   BOT,   BOT,   BOT,   BOT,
-    BOT,   MINUS, BOT,   MINUS, MINUS,
-    BOT,   ZERO,  BOT,   ZERO,  ZERO,
-    BOT,   PLUS,  BOT,   PLUS,  PLUS,
-    BOT,   TOP,   BOT,   TOP,   TOP
-  };
   
-  rem.value = table[value * 5 + other.value];
+  rem.value = remainders[value][other.value];
   
   return rem;
 }
@@ -239,15 +180,8 @@ Sign Sign::operator%(Sign other)
 Sign Sign::operator^(Sign other)
 {
   Sign pow;
-  signType table[] = {
-    BOT,   BOT,   BOT,   BOT,   BOT,
-    BOT,   ZERO,  PLUS,  TOP,   TOP,
-    BOT,   BOT,   BOT,   ZERO,  ZERO,
-    BOT,   ZERO,  PLUS,  PLUS,  TOP,
-    BOT,   ZERO,  PLUS,  TOP,   TOP
-  };
   
-  pow.value = table[value * 5 + other.value];
+  pow.value = powers[value][other.value];
   
   return pow;
 }
@@ -283,6 +217,17 @@ bool Sign::equal(Sign a, Sign b)
 }
 
 
+/** Hash function.
+ * Values which are equal, according to equal(), have the same hash.
+ * @param[in]  a           Abstract value
+ * @retval     size_t      Hash of the value
+ */
+size_t Sign::hash(Sign a)
+{
+  return (size_t) a.value;
+}
+
+
 /** Least upperbound between two values in the abstract domain is
  * computed.
  * @param[in]  a           First abstract value
@@ -292,30 +237,22 @@ bool Sign::equal(Sign a, Sign b)
 Sign Sign::lub(Sign a, Sign b)
 {
   Sign lub;
-  signType table[] = {
-    BOT,   MINUS, ZERO,  PLUS,  TOP,
-    MINUS, MINUS, TOP,   TOP,   TOP,
-    ZERO,  TOP,   ZERO,  TOP,   TOP,
-    PLUS,  TOP,   TOP,   PLUS,  TOP,
-    TOP,   TOP,   TOP,   TOP,   TOP
-  };
   
-  lub.value = table[a.value * 5 + b.value];
+  lub.value = lubs[a.value][b.value];
   
   return lub;
 }
 
 
 /** Widening operator.
- * No actual widening is used in the Sign domain.
+ * Least upperbound is enough, since the domain is finite.
  * @param[in]  a           Previous value
  * @param[in]  b           Current value
  * @retval     Sign        Widened value
  */
 Sign Sign::nabla(Sign a, Sign b)
 {
-  (void) a;
-  return b;
+  return lub(a, b);
 }
 
 
@@ -366,3 +303,79 @@ Sign Sign::top()
   
   return top;
 }
+
+
+/** Bounds of the concrete values are provided.
+ * This method is used by reduced products to exchange information
+ * between domains. Missing bounds are represented by the limits of
+ * long, bottom is represented by an empty range.
+ * @param[out] lower       Lower bound of the concrete values
+ * @param[out] upper       Upper bound of the concrete values
+ */
+void Sign::bounds(long &lower, long &upper)
+{
+  lower = numeric_limits<long>::min();
+  upper = numeric_limits<long>::max();
+  
+  switch(value){
+    case BOT:   lower = 1L; upper = 0L; break;
+    case MINUS: upper = -1L;            break;
+    case ZERO:  lower = 0L; upper = 0L; break;
+    case PLUS:  lower = 1L;             break;
+    default:                            break;
+  }
+}
+
+
+/** Value is refined by the given bounds.
+ * This method is used by reduced products to exchange information
+ * between domains. Value becomes bottom if the range is empty.
+ * @param[in]  lower       Lower bound of the concrete values
+ * @param[in]  upper       Upper bound of the concrete values
+ */
+void Sign::meet(long lower, long upper)
+{
+  signType range;
+  
+  // Sign of the range is detected.
+  if     (lower > upper)              { range = BOT;   }
+  else if(upper < 0L)                 { range = MINUS; }
+  else if(lower > 0L)                 { range = PLUS;  }
+  else if(lower == 0L && upper == 0L) { range = ZERO;  }
+  else                                { range = TOP;   }
+  
+  if     (range == TOP || value == range){ return; }
+  else if(value == TOP)                  { value = range; }
+  else                                   { value = BOT; }
+}
+
+
+/** A binary transfer function is applied to arrays of values.
+ * The i-th result is the operation applied to the i-th operands.
+ * Lookup table is selected once for the whole arrays.
+ * @param[in]  operation   Transfer function to be applied
+ * @param[in]  a           Left-operands
+ * @param[in]  b           Right-operands
+ * @param[out] result      Results, which may alias an operand
+ * @param[in]  n           Length of the arrays
+ */
+void Sign::apply(operationType operation, const Sign *a, const Sign *b,
+                 Sign *result, size_t n)
+{
+  const signType (*table)[5];
+  size_t i;
+  
+  switch(operation){
+    case SUM: table = sums;        break;
+    case SUB: table = differences; break;
+    case MUL: table = products;    break;
+    case DIV: table = quotients;   break;
+    case REM: table = remainders;  break;
+    case POW: table = powers;      break;
+    default:  table = lubs;        break;
+  }
+  
+  for(i = 0; i < n; ++i){
+    result[i].value = table[a[i].value][b[i].value];
+  }
+}
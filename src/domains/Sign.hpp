@@ -145,6 +145,14 @@ class Sign
   static bool equal(Sign a, Sign b);
   
   
+  /** Hash function.
+   * Values which are equal, according to equal(), have the same hash.
+   * @param[in]  a           Abstract value
+   * @retval     size_t      Hash of the value
+   */
+  static size_t hash(Sign a);
+  
+  
   /** Least upperbound between two values in the abstract domain is
    * computed.
    * @param[in]  a           First abstract value
@@ -155,7 +163,7 @@ class Sign
   
   
   /** Widening operator.
-   * No actual widening is used in the Sign domain.
+   * Least upperbound is enough, since the domain is finite.
    * @param[in]  a           Previous value
    * @param[in]  b           Current value
    * @retval     Sign        Widened value
@@ -186,6 +194,50 @@ class Sign
   static Sign top();
   
   
+  /** Bounds of the concrete values are provided.
+   * This method is used by reduced products to exchange information
+   * between domains. Missing bounds are represented by the limits of
+   * long, bottom is represented by an empty range.
+   * @param[out] lower       Lower bound of the concrete values
+   * @param[out] upper       Upper bound of the concrete values
+   */
+  void bounds(long &lower, long &upper);
+  
+  
+  /** Value is refined by the given bounds.
+   * This method is used by reduced products to exchange information
+   * between domains. Value becomes bottom if the range is empty.
+   * @param[in]  lower       Lower bound of the concrete values
+   * @param[in]  upper       Upper bound of the concrete values
+   */
+  void meet(long lower, long upper);
+  
+  
+  /** Type representing the binary transfer functions. */
+  typedef enum{
+    SUM,                ///< Sum
+    SUB,                ///< Subtraction
+    MUL,                ///< Multiplication
+    DIV,                ///< Integer division
+    REM,                ///< Remainder of the integer division
+    POW,                ///< Power raising
+    LUB                 ///< Least upperbound
+  } operationType;
+  
+  
+  /** A binary transfer function is applied to arrays of values.
+   * The i-th result is the operation applied to the i-th operands.
+   * Lookup table is selected once for the whole arrays.
+   * @param[in]  operation   Transfer function to be applied
+   * @param[in]  a           Left-operands
+   * @param[in]  b           Right-operands
+   * @param[out] result      Results, which may alias an operand
+   * @param[in]  n           Length of the arrays
+   */
+  static void apply(operationType operation, const Sign *a, const Sign *b,
+                    Sign *result, size_t n);
+  
+  
   private:
   /** Type representing every possible value in the domain. */
   typedef enum{
@@ -197,5 +249,100 @@ class Sign
   } signType;
   
   signType value;       ///< Abstract value
+  
+  
+  // Transfer functions and comparisons are looked up in tables built at
+  // compile time, indexed by the values of the operands.
+  static constexpr signType opposites[5] = {BOT, PLUS, ZERO, MINUS, TOP};
+  
+  static constexpr signType sums[5][5] = {
+    {BOT,   BOT,   BOT,   BOT,   BOT},
+    {BOT,   MINUS, MINUS, TOP,   TOP},
+    {BOT,   MINUS, ZERO,  PLUS,  TOP},
+    {BOT,   TOP,   PLUS,  PLUS,  TOP},
+    {BOT,   TOP,   TOP,   TOP,   TOP}
+  };
+  
+  static constexpr signType differences[5][5] = {
+    {BOT,   BOT,   BOT,   BOT,   BOT},
+    {BOT,   TOP,   MINUS, MINUS, TOP},
+    {BOT,   PLUS,  ZERO,  MINUS, TOP},
+    {BOT,   PLUS,  PLUS,  TOP,   TOP},
+    {BOT,   TOP,   TOP,   TOP,   TOP}
+  };
+  
+  static constexpr signType products[5][5] = {
+    {BOT,   BOT,   BOT,   BOT,   BOT},
+    {BOT,   PLUS,  ZERO,  MINUS, TOP},
+    {BOT,   ZERO,  ZERO,  ZERO,  ZERO},
+    {BOT,   MINUS, ZERO,  PLUS,  TOP},
+    {BOT,   TOP,   ZERO,  TOP,   TOP}
+  };
+  
+  static constexpr signType quotients[5][5] = {
+    {BOT,   BOT,   BOT,   BOT,   BOT},
+    {BOT,   TOP,   BOT,   TOP,   TOP},
+    {BOT,   ZERO,  BOT,   ZERO,  ZERO},
+    {BOT,   TOP,   BOT,   TOP,   TOP},
+    {BOT,   TOP,   BOT,   TOP,   TOP}
+  };
+  
+  // Remainder may be zero whatever the sign of the dividend, and
+  // negative exponents give 1 as for the zero one.
+  static constexpr signType remainders[5][5] = {
+    {BOT,   BOT,   BOT,   BOT,   BOT},
+    {BOT,   TOP,   BOT,   TOP,   TOP},
+    {BOT,   ZERO,  BOT,   ZERO,  ZERO},
+    {BOT,   TOP,   BOT,   TOP,   TOP},
+    {BOT,   TOP,   BOT,   TOP,   TOP}
+  };
+  
+  static constexpr signType powers[5][5] = {
+    {BOT,   BOT,   BOT,   BOT,   BOT},
+    {BOT,   PLUS,  PLUS,  TOP,   TOP},
+    {BOT,   PLUS,  PLUS,  ZERO,  TOP},
+    {BOT,   PLUS,  PLUS,  PLUS,  PLUS},
+    {BOT,   PLUS,  PLUS,  TOP,   TOP}
+  };
+  
+  static constexpr signType lubs[5][5] = {
+    {BOT,   MINUS, ZERO,  PLUS,  TOP},
+    {MINUS, MINUS, TOP,   TOP,   TOP},
+    {ZERO,  TOP,   ZERO,  TOP,   TOP},
+    {PLUS,  TOP,   TOP,   PLUS,  TOP},
+    {TOP,   TOP,   TOP,   TOP,   TOP}
+  };
+  
+  static constexpr bool lesser[5][5] = {
+    {false, false, false, false, false},
+    {false, true,  true,  true,  true },
+    {false, false, false, true,  true },
+    {false, false, false, true,  true },
+    {false, true,  true,  true,  true }
+  };
+  
+  static constexpr bool lesserEqual[5][5] = {
+    {false, false, false, false, false},
+    {false, true,  true,  true,  true },
+    {false, false, true,  true,  true },
+    {false, false, false, true,  true },
+    {false, true,  true,  true,  true }
+  };
+  
+  static constexpr bool equalTo[5][5] = {
+    {false, false, false, false, false},
+    {false, true,  false, false, true },
+    {false, false, true,  false, true },
+    {false, false, false, true,  true },
+    {false, true,  true,  true,  true }
+  };
+  
+  static constexpr bool notEqualTo[5][5] = {
+    {false, false, false, false, false},
+    {false, true,  true,  true,  true },
+    {false, true,  false, true,  true },
+    {false, true,  true,  true,  true },
+    {false, true,  true,  true,  true }
+  };
 };
 #endif
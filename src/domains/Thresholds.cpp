@@ -0,0 +1,63 @@
+/** Widening thresholds.
+ * Class handling the thresholds used by the widening operators of the
+ * numeric abstract domains.
+ * 
+ * @file Thresholds.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ * @ingroup domains
+ */
+#include <algorithm>
+#include <limits>
+
+#include "Thresholds.hpp"
+
+
+vector<long> Thresholds::thresholds;
+
+
+/** Thresholds are set.
+ * @param[in]  values      Thresholds, in any order
+ */
+void Thresholds::set(const vector<long> &values)
+{
+  thresholds = values;
+  sort(thresholds.begin(), thresholds.end());
+  thresholds.erase(unique(thresholds.begin(), thresholds.end()),
+                   thresholds.end());
+}
+
+
+/** Smallest threshold greater than or equal to the given bound.
+ * Infinity is represented by the limits of short, as in the domains.
+ * @param[in]  bound       Bound to be widened
+ * @retval     long        Threshold, or +inf if there is none
+ */
+long Thresholds::above(long bound)
+{
+  vector<long>::iterator it;
+  
+  it = lower_bound(thresholds.begin(), thresholds.end(), bound);
+  if(it == thresholds.end() || *it >= numeric_limits<short>::max()){
+    return numeric_limits<short>::max();
+  }
+  
+  return *it;
+}
+
+
+/** Greatest threshold smaller than or equal to the given bound.
+ * Infinity is represented by the limits of short, as in the domains.
+ * @param[in]  bound       Bound to be widened
+ * @retval     long        Threshold, or -inf if there is none
+ */
+long Thresholds::below(long bound)
+{
+  vector<long>::iterator it;
+  
+  it = upper_bound(thresholds.begin(), thresholds.end(), bound);
+  if(it == thresholds.begin() || *(it - 1) <= numeric_limits<short>::min()){
+    return numeric_limits<short>::min();
+  }
+  
+  return *(it - 1);
+}
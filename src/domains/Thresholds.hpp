@@ -0,0 +1,50 @@
+/** Widening thresholds.
+ * Class handling the thresholds used by the widening operators of the
+ * numeric abstract domains.
+ * 
+ * @file Thresholds.hpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ * @ingroup domains
+ */
+#ifndef _THRESHOLDS_HPP_
+#define _THRESHOLDS_HPP_
+
+#include <vector>
+
+using namespace std;
+
+/** Class representing the thresholds of widening.
+ * A bound which keeps growing is widened to the nearest threshold
+ * instead of jumping straight to infinity, so that bounds found in the
+ * program, such as the limit of a loop counter, can be reached. There
+ * are finitely many thresholds, hence widening still terminates.
+ * Thresholds are set once, before any analysis is started, and are
+ * only read afterwards.
+ */
+class Thresholds
+{
+  public:
+  /** Thresholds are set.
+   * @param[in]  values      Thresholds, in any order
+   */
+  static void set(const vector<long> &values);
+  
+  
+  /** Smallest threshold greater than or equal to the given bound.
+   * @param[in]  bound       Bound to be widened
+   * @retval     long        Threshold, or +inf if there is none
+   */
+  static long above(long bound);
+  
+  
+  /** Greatest threshold smaller than or equal to the given bound.
+   * @param[in]  bound       Bound to be widened
+   * @retval     long        Threshold, or -inf if there is none
+   */
+  static long below(long bound);
+  
+  
+  private:
+  static vector<long> thresholds;   ///< Thresholds, in ascending order
+};
+#endif
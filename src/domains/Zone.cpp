@@ -0,0 +1,369 @@
+/** Zone abstract interpretation.
+ * Class handling the abstract interpretation in the Zone relational
+ * abstract domain, and the abstract state over it.
+ *
+ * @file Zone.cpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ * @ingroup domains
+ */
+#include <limits>
+#include <functional>
+
+#include "Zone.hpp"
+
+
+const long Zone::Inf = numeric_limits<long>::max();
+
+unsigned long AbstractState<Zone>::copies      = 0;
+unsigned long AbstractState<Zone>::comparisons = 0;
+
+
+/** Constructor of the zone with no constraints.
+ * @param[in]  variables   Number of variables
+ */
+Zone::Zone(unsigned int variables)
+{
+  const unsigned int width = sizeof(Line) / sizeof(long);
+  unsigned int i, j;
+
+  size   = variables + 1;
+  stride = (size + width - 1) / width * width;
+  lines.resize(size * stride / width);
+  bound.assign(variables, false);
+  empty  = false;
+
+  for(i = 0; i < size; ++i){
+    for(j = 0; j < stride; ++j){ at(i, j) = (i == j) ? 0 : Inf; }
+  }
+}
+
+
+/** 'Less than or equal to' operator overloading.
+ * @param[in]  other       Zone to be compared
+ * @retval     bool        True if every bound of the current zone is
+ *                         at least as tight as the one in the other
+ */
+bool Zone::operator<=(const Zone &other) const
+{
+  unsigned int i, j;
+
+  if(empty || other.empty){ return empty; }
+  for(i = 0; i < size; ++i){
+    for(j = 0; j < size; ++j){
+      if(at(i, j) > other.at(i, j)){ return false; }
+    }
+  }
+
+  return true;
+}
+
+
+/** 'Equal to' operator overloading.
+ * @param[in]  other       Zone to be compared
+ * @retval     bool        True if and only if zones have the same
+ *                         bounds and the same bound variables
+ */
+bool Zone::operator==(const Zone &other) const
+{
+  unsigned int i, j;
+
+  if(empty || other.empty){ return empty == other.empty; }
+  if(bound != other.bound){ return false; }
+  for(i = 0; i < size; ++i){
+    for(j = 0; j < size; ++j){
+      if(at(i, j) != other.at(i, j)){ return false; }
+    }
+  }
+
+  return true;
+}
+
+
+/** Predicate testing whether the zone has no concrete value.
+ * @retval     bool        True if constraints are not satisfiable
+ */
+bool Zone::isEmpty() const
+{
+  return empty;
+}
+
+
+/** Variable is assigned a value within the given bounds.
+ * Row and column of the variable are rebuilt from the ones of the zero
+ * variable, which keeps the matrix closed. Zone becomes empty if the
+ * range is, rather than holding a negative cycle.
+ * @param[in]  x           Slot of the assigned variable
+ * @param[in]  lower       Lower bound of the value
+ * @param[in]  upper       Upper bound of the value
+ */
+void Zone::assign(unsigned int x, long lower, long upper)
+{
+  unsigned int k = x + 1, i;
+  long up   = (upper == numeric_limits<long>::max()) ? Inf : upper;
+  long down = (lower == numeric_limits<long>::min()) ? Inf : -lower;
+
+  if(empty){ return; }
+  if(lower > upper){
+    empty = true;
+    return;
+  }
+  for(i = 0; i < size; ++i){
+    at(i, k) = add(at(i, 0), up);
+    at(k, i) = add(at(0, i), down);
+  }
+  at(0, k) = up;
+  at(k, 0) = down;
+  at(k, k) = 0;
+  bound[x] = true;
+}
+
+
+/** Variable is assigned another variable plus a constant.
+ * Row and column of the assigned variable are rebuilt from the ones of
+ * the other variable, or shifted if they are the same variable, which
+ * keeps the matrix closed.
+ * @param[in]  x           Slot of the assigned variable
+ * @param[in]  y           Slot of the variable in the expression
+ * @param[in]  c           Constant in the expression
+ */
+void Zone::assign(unsigned int x, unsigned int y, long c)
+{
+  unsigned int k = x + 1, l = y + 1, i;
+
+  for(i = 0; i < size; ++i){
+    if(i == k){ continue; }
+    if(k == l){
+      at(i, k) = add(at(i, k), c);
+      at(k, i) = add(at(k, i), -c);
+    }
+    else{
+      at(i, k) = add(at(i, l), c);
+      at(k, i) = add(at(l, i), -c);
+    }
+  }
+  at(k, k) = 0;
+  bound[x] = true;
+}
+
+
+/** Every constraint on a variable is removed.
+ * @param[in]  x           Slot of the variable
+ */
+void Zone::forget(unsigned int x)
+{
+  unsigned int k = x + 1, i;
+
+  for(i = 0; i < size; ++i){
+    at(i, k) = Inf;
+    at(k, i) = Inf;
+  }
+  at(k, k) = 0;
+  bound[x] = false;
+}
+
+
+/** Constraint x - y <= c is added.
+ * Zone may become empty.
+ * @param[in]  x           Slot of the first variable
+ * @param[in]  y           Slot of the second variable
+ * @param[in]  c           Bound of the difference
+ */
+void Zone::constrain(unsigned int x, unsigned int y, long c)
+{
+  tighten(y + 1, x + 1, c);
+}
+
+
+/** Variable is refined by the given bounds.
+ * Missing bounds are represented by the limits of long. Zone may
+ * become empty.
+ * @param[in]  x           Slot of the variable
+ * @param[in]  lower       Lower bound of the variable
+ * @param[in]  upper       Upper bound of the variable
+ */
+void Zone::meet(unsigned int x, long lower, long upper)
+{
+  if(lower > upper){
+    empty = true;
+    return;
+  }
+  if(upper != numeric_limits<long>::max()){ tighten(0, x + 1, upper); }
+  if(lower != numeric_limits<long>::min()){ tighten(x + 1, 0, -lower); }
+}
+
+
+/** Bounds of a variable are provided.
+ * Missing bounds are represented by the limits of long.
+ * @param[in]  x           Slot of the variable
+ * @param[out] lower       Lower bound of the variable
+ * @param[out] upper       Upper bound of the variable
+ */
+void Zone::bounds(unsigned int x, long &lower, long &upper) const
+{
+  long up = at(0, x + 1), down = at(x + 1, 0);
+
+  lower = (down == Inf) ? numeric_limits<long>::min() : -down;
+  upper = (up   == Inf) ? numeric_limits<long>::max() : up;
+}
+
+
+/** Bounds of the difference x - y are provided.
+ * Missing bounds are represented by the limits of long.
+ * @param[in]  x           Slot of the first variable
+ * @param[in]  y           Slot of the second variable
+ * @param[out] lower       Lower bound of the difference
+ * @param[out] upper       Upper bound of the difference
+ */
+void Zone::difference(unsigned int x, unsigned int y,
+                      long &lower, long &upper) const
+{
+  long up = at(y + 1, x + 1), down = at(x + 1, y + 1);
+
+  lower = (down == Inf) ? numeric_limits<long>::min() : -down;
+  upper = (up   == Inf) ? numeric_limits<long>::max() : up;
+}
+
+
+/** Least upperbound with the given zone is computed in place.
+ * Loosest bound of each entry is kept, which keeps closed matrices
+ * closed.
+ * @param[in]  other       Zone to be joined with the current one
+ */
+void Zone::join(const Zone &other)
+{
+  unsigned int i, j;
+
+  if(other.empty){ return; }
+  if(empty){
+    *this = other;
+    return;
+  }
+  for(i = 0; i < size; ++i){
+    for(j = 0; j < size; ++j){
+      if(other.at(i, j) > at(i, j)){ at(i, j) = other.at(i, j); }
+    }
+  }
+  for(i = 0; i < bound.size(); ++i){
+    bound[i] = bound[i] || other.bound[i];
+  }
+}
+
+
+/** Widening is applied in place.
+ * Bounds which grew since the previous zone are removed.
+ * @param[in]  previous    Zone reached by the previous iteration
+ */
+void Zone::widen(const Zone &previous)
+{
+  unsigned int i, j;
+
+  if(empty || previous.empty){ return; }
+  for(i = 0; i < size; ++i){
+    for(j = 0; j < size; ++j){
+      if(at(i, j) > previous.at(i, j)){ at(i, j) = Inf; }
+    }
+  }
+}
+
+
+/** Every bound which changed since the previous zone is removed.
+ * @param[in]  previous    Zone reached by the previous iteration
+ */
+void Zone::saturate(const Zone &previous)
+{
+  unsigned int i, j;
+
+  if(empty || previous.empty){ return; }
+  for(i = 0; i < size; ++i){
+    for(j = 0; j < size; ++j){
+      if(at(i, j) != previous.at(i, j)){ at(i, j) = Inf; }
+    }
+  }
+}
+
+
+/** Hash function.
+ * Zones which are equal have the same hash.
+ * @retval     size_t      Hash of the zone
+ */
+size_t Zone::hash() const
+{
+  unsigned int i, j;
+  size_t h = 0;
+
+  if(empty){ return 0; }
+  for(i = 0; i < size; ++i){
+    for(j = 0; j < size; ++j){ h = h * 31 + std::hash<long>()(at(i, j)); }
+  }
+
+  return h;
+}
+
+
+/** A textual representation of the zone is provided.
+ * Bounds of every bound variable are listed, then the differences
+ * which are tighter than the ones implied by such bounds.
+ * @param[out] out         Output stream
+ * @param[in]  names       Name of the variable in each slot
+ */
+void Zone::dump(ostream &out, const vector<string> &names) const
+{
+  unsigned int i, j;
+  long up, down;
+
+  for(i = 1; i < size; ++i){
+    if(!bound[i - 1]){ continue; }
+    up   = at(0, i);
+    down = at(i, 0);
+    out << names[i - 1] << " -> "
+        << ((down == Inf) ? "(-inf" : "[" + to_string(-down)) << "; "
+        << ((up   == Inf) ? "+inf)" : to_string(up) + "]") << ", ";
+  }
+
+  for(i = 1; i < size; ++i){
+    for(j = i + 1; j < size; ++j){
+      if(!bound[i - 1] || !bound[j - 1]){ continue; }
+      up   = at(i, j);
+      down = at(j, i);
+      if(up >= add(at(i, 0), at(0, j)) && down >= add(at(j, 0), at(0, i))){
+        continue;
+      }
+      out << names[j - 1] << " - " << names[i - 1] << " -> "
+          << ((down == Inf) ? "(-inf" : "[" + to_string(-down)) << "; "
+          << ((up   == Inf) ? "+inf)" : to_string(up) + "]") << ", ";
+    }
+  }
+}
+
+
+/** Constraint x_j - x_i <= c is added and the matrix is closed.
+ * Every entry is relaxed through the new constraint: a closed matrix
+ * is closed again in O(n^2), instead of the O(n^3) of a full closure.
+ * Zone is empty if the constraint closes a negative cycle.
+ * @param[in]  i           Index of the subtracted variable
+ * @param[in]  j           Index of the other variable
+ * @param[in]  c           Bound of the difference
+ */
+void Zone::tighten(unsigned int i, unsigned int j, long c)
+{
+  unsigned int a, b;
+  long through;
+
+  if(empty || c >= at(i, j)){ return; }
+  if(add(at(j, i), c) < 0){
+    empty = true;
+    return;
+  }
+
+  for(a = 0; a < size; ++a){
+    through = add(at(a, i), c);
+    if(through == Inf){ continue; }
+    for(b = 0; b < size; ++b){
+      if(add(through, at(j, b)) < at(a, b)){ at(a, b) = through + at(j, b); }
+    }
+  }
+
+  for(a = 0; a < size; ++a){
+    if(at(a, a) < 0){ empty = true; }
+  }
+}
@@ -11,10 +11,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <iostream>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <atomic>
 
-#include "domains.hpp"
+#include "analyses.hpp"
 #include "AbstractState.hpp"
 #include "AST.hpp"
+#include "Bytecode.hpp"
+#include "CFG.hpp"
+#include "parser/parser.hpp"
 
 using namespace std;
 
@@ -24,14 +31,45 @@ string source_path = "-";         ///< Path of the source file, if any
 bool export_ast    = false;       ///< True if a dot file representing the
                                   ///<  Abstract Syntax Tree shall be created
 string ast_path    = "ast.dot";   ///< Path to the output ast dot file
+bool export_opt    = false;       ///< True if a dot file representing the
+                                  ///<  optimized Abstract Syntax Tree shall
+                                  ///<  be created
+string opt_path    = "opt.dot";   ///< Path to the output optimized ast
+                                  ///<  dot file
+string emit_path   = "";          ///< Path to the binary cache to be
+                                  ///<  written, if any
+string cache_path  = "";          ///< Path to the binary cache to be
+                                  ///<  loaded instead of the source, if any
+bool run           = false;       ///< True if the program shall be
+                                  ///<  concretely executed
+bool stats         = false;       ///< True if statistics about the
+                                  ///<  analyses shall be printed
+unsigned int jobs  = 1;           ///< Number of analyses which can be
+                                  ///<  run concurrently
+bool cfg           = false;       ///< True if the analyses shall run on
+                                  ///<  the control flow graph
+vector<string> selected;          ///< Keys of the domains to be analyzed,
+                                  ///<  the standard ones if empty
+bool live          = false;       ///< True if dead variables shall be
+                                  ///<  dropped from the states
+vector<string> observed;          ///< Variables kept in the final state
+                                  ///<  when dead variables are dropped
+bool thresholds    = false;       ///< True if constants of the program
+                                  ///<  shall be used as widening thresholds
+AST::Strategy strategy = {0, 0, 0}; ///< Iteration strategy of loops
 
 
-
-/** Source code is parsed.
- * @param[in]  file_path     Path to the source file
- * @retval     AST *         Abstract syntax tree of the program
+/** Analyses are run on a pool of threads.
+ * Every thread repeatedly takes the next analysis which has not been
+ * started yet. Results are stored in the same order of the analyses,
+ * so that they can be printed deterministically.
+ * @param[in]  program       Abstract syntax tree of the program
+ * @param[in]  graph         Control flow graph of the program, if any
+ * @param[in]  analyses      Analyses to be run
+ * @param[out] results       Result of each analysis
  */
-AST *parse(const char *file_path);
+void analyzeAll(const AST *program, const CFG *graph,
+                const vector<Analysis> &analyses, vector<string> &results);
 
 
 
@@ -57,48 +95,110 @@ void init(int argc, char *argv[]);
 int main(int argc, char *argv[])
 {
   AST *P;
+  vector<Analysis> available = registry(Domains()), analyses;
+  string unknown;
+  unsigned int i;
   
   // Parse options.
   init(argc, argv);
+  if(!select(available, selected, analyses, unknown)){
+    cerr << "[While]: Unknown domain '" << unknown << "', available:";
+    for(i = 0; i < available.size(); ++i){
+      cerr << " " << available[i].key;
+    }
+    cerr << "." << endl;
+    return EXIT_FAILURE;
+  }
   
-  // Abstract Syntax Tree is created.
-  P = parse(source_path.c_str());
-  if(NULL == P){
-    cerr << "[While]: Nothing to be done." << endl;
-    return EXIT_SUCCESS;
+  // Abstract Syntax Tree is loaded from a cache, already optimized.
+  if(!cache_path.empty()){
+    P = AST::load(cache_path.c_str());
+    if(NULL == P){
+      cerr << "[While]: Cache cannot be loaded." << endl;
+      return EXIT_FAILURE;
+    }
   }
   
-  // Abstract Syntax Tree is exported, if asked.
-  if(export_ast){
-    P->toGraphviz(ast_path.c_str());
+  // Abstract Syntax Tree is created otherwise.
+  else{
+    P = parse(source_path.c_str());
+    if(NULL == P){
+      cerr << "[While]: Nothing to be done." << endl;
+      return EXIT_SUCCESS;
+    }
+    
+    // Every identifier is bound to a slot.
+    P->resolve();
+    
+    // Abstract Syntax Tree is exported, if asked.
+    if(export_ast){
+      P->toGraphviz(ast_path.c_str());
+    }
+    
+    // Abstract Syntax Tree is optimized.
+    P->optimize();
   }
   
-  // Concrete execution.
-  //AbstractState<int> concreteState = P->execute();
-  //cout << "Concrete domain:   ";
-  //concreteState.dump();
+  // Optimized Abstract Syntax Tree is cached and exported, if asked.
+  if(!emit_path.empty() && !P->save(emit_path.c_str())){
+    delete P;
+    return EXIT_FAILURE;
+  }
+  if(export_opt){
+    P->toGraphviz(opt_path.c_str());
+  }
   
-  // Abstract executions.
-  AbstractState<Sign> signS = P->interpret<Sign>();
-  cout << "Sign domain:       ";
-  signS.dump();
+  // Dead variables are detected, if asked.
+  if(live){
+    P->liveness(observed);
+  }
+  
+  // Iteration strategy of loops is set.
+  P->setStrategy(strategy);
+  if(thresholds){
+    Thresholds::set(P->constants());
+  }
   
-  AbstractState<Interval> intervalS = P->interpret<Interval>();
-  cout << "Interval domain:   ";
-  intervalS.dump();
+  // Variables which are never related are kept in separate octagons.
+  AbstractState<Octagon>::setPacks(P->packs());
   
-  AbstractState<SInterval> sintervalS = P->interpret<SInterval>();
-  cout << "S-Interval domain: ";
-  sintervalS.dump();
-
-  AbstractState< Modulo<2> > modulo2S = P->interpret< Modulo<2> >();
-  cout << "Modulo 2 domain:   ";
-  modulo2S.dump();
+  // Concrete execution, through the bytecode virtual machine.
+  if(run){
+    Bytecode program(P);
+    AbstractState<int> concreteState = program.run();
+    cout << "Concrete domain:   ";
+    concreteState.dump();
+    delete P;
+    return EXIT_SUCCESS;
+  }
   
-  AbstractState< Modulo<3> > modulo3S = P->interpret< Modulo<3> >();
-  cout << "Modulo 3 domain:   ";
-  modulo3S.dump();
+  // Abstract executions.
+  vector<string> results(analyses.size());
+  CFG *G = cfg ? new CFG(P) : NULL;
+  unsigned long copies, comparisons;
   
+  analyzeAll(P, G, analyses, results);
+  for(i = 0; i < analyses.size(); ++i){
+    string label = string(analyses[i].name) + " domain:";
+    
+    label.resize(19, ' ');
+    cout << label << results[i];
+  }
+  
+  // Statistics are printed, if asked.
+  if(stats){
+    ostringstream copy, comparison;
+    
+    for(i = 0; i < analyses.size(); ++i){
+      analyses[i].counters(copies, comparisons);
+      copy       << (i ? ", " : "") << analyses[i].name << " " << copies;
+      comparison << (i ? ", " : "") << analyses[i].name << " " << comparisons;
+    }
+    cout << "State copies:      " << copy.str()       << endl;
+    cout << "Full comparisons:  " << comparison.str() << endl;
+  }
+  
+  delete G;
   delete P;
   
   return EXIT_SUCCESS;
@@ -106,6 +206,45 @@ int main(int argc, char *argv[])
 
 
 
+/** Analyses are run on a pool of threads.
+ * Every thread repeatedly takes the next analysis which has not been
+ * started yet. Results are stored in the same order of the analyses,
+ * so that they can be printed deterministically.
+ * @param[in]  program       Abstract syntax tree of the program
+ * @param[in]  graph         Control flow graph of the program, if any
+ * @param[in]  analyses      Analyses to be run
+ * @param[out] results       Result of each analysis
+ */
+void analyzeAll(const AST *program, const CFG *graph,
+                const vector<Analysis> &analyses, vector<string> &results)
+{
+  atomic<size_t> next(0);
+  vector<thread> pool;
+  unsigned int i, threads;
+  
+  // Every worker takes analyses until none is left.
+  auto worker = [&](){
+    size_t a;
+    
+    while((a = next++) < analyses.size()){
+      results[a] = analyses[a].run(program, graph);
+    }
+  };
+  
+  // Calling thread takes part in the work, too.
+  threads = (jobs < analyses.size()) ? jobs : analyses.size();
+  for(i = 1; i < threads; ++i){
+    pool.push_back(thread(worker));
+  }
+  worker();
+  
+  for(i = 0; i < pool.size(); ++i){
+    pool[i].join();
+  }
+}
+
+
+
 /** Program options are read from the command line.
  * @param[in]  argc          ARGument Counter
  * @param[in]  argv          ARGument Vector
@@ -122,6 +261,99 @@ void init(int argc, char *argv[])
       ast_path   = argv[++i];
     }
     
+    // Optimized AST export is requested.
+    else if((strcmp("--optimized", argv[i]) == 0
+             || strcmp("-o", argv[i]) == 0) && (i+1 < argc)){
+      export_opt = true;
+      opt_path   = argv[++i];
+    }
+    
+    // Binary cache of the optimized AST is requested.
+    else if((strcmp("--emit-cache", argv[i]) == 0
+             || strcmp("-e", argv[i]) == 0) && (i+1 < argc)){
+      emit_path = argv[++i];
+    }
+    
+    // Binary cache is loaded instead of the source.
+    else if((strcmp("--load-cache", argv[i]) == 0
+             || strcmp("-k", argv[i]) == 0) && (i+1 < argc)){
+      cache_path = argv[++i];
+    }
+    
+    // Concrete execution is requested.
+    else if(strcmp("--run", argv[i]) == 0 || strcmp("-r", argv[i]) == 0){
+      run = true;
+    }
+    
+    // Concurrent analyses are requested.
+    else if((strcmp("--jobs", argv[i]) == 0 || strcmp("-j", argv[i]) == 0)
+            && (i+1 < argc)){
+      jobs = atoi(argv[++i]);
+      if(jobs < 1){ jobs = 1; }
+    }
+    
+    // Control flow graph engine is requested.
+    else if(strcmp("--cfg", argv[i]) == 0 || strcmp("-c", argv[i]) == 0){
+      cfg = true;
+    }
+    
+    // Reduced product is requested.
+    else if(strcmp("--product", argv[i]) == 0 || strcmp("-p", argv[i]) == 0){
+      selected.push_back("product");
+    }
+    
+    // Domains are selected.
+    else if((strcmp("--domain", argv[i]) == 0 || strcmp("-d", argv[i]) == 0)
+            && (i+1 < argc)){
+      istringstream keys(argv[++i]);
+      string key;
+      
+      while(getline(keys, key, ',')){
+        selected.push_back(key);
+      }
+    }
+    
+    // Dropping of dead variables is requested.
+    else if((strcmp("--live", argv[i]) == 0 || strcmp("-l", argv[i]) == 0)
+            && (i+1 < argc)){
+      istringstream names(argv[++i]);
+      string name;
+      
+      live = true;
+      while(getline(names, name, ',')){
+        observed.push_back(name);
+      }
+    }
+    
+    // Widening thresholds are requested.
+    else if(strcmp("--thresholds", argv[i]) == 0
+            || strcmp("-t", argv[i]) == 0){
+      thresholds = true;
+    }
+    
+    // Widening delay is requested.
+    else if((strcmp("--delay", argv[i]) == 0 || strcmp("-w", argv[i]) == 0)
+            && (i+1 < argc)){
+      strategy.delay = atoi(argv[++i]);
+    }
+    
+    // Narrowing is requested.
+    else if((strcmp("--narrowing", argv[i]) == 0
+             || strcmp("-n", argv[i]) == 0) && (i+1 < argc)){
+      strategy.narrowing = atoi(argv[++i]);
+    }
+    
+    // Iteration budget is requested.
+    else if((strcmp("--budget", argv[i]) == 0 || strcmp("-b", argv[i]) == 0)
+            && (i+1 < argc)){
+      strategy.budget = atoi(argv[++i]);
+    }
+    
+    // Statistics are requested.
+    else if(strcmp("--stats", argv[i]) == 0 || strcmp("-s", argv[i]) == 0){
+      stats = true;
+    }
+    
     // Helper.
     else if(strcmp("--help", argv[i]) == 0 || strcmp("-h", argv[i]) == 0){
       cout
@@ -130,6 +362,28 @@ void init(int argc, char *argv[])
       << "Usage: while [options] [file]\n\n"
       << "List of options:\n"
       << "  -a, --ast FILE   AST is exported in dot format to FILE\n"
+      << "  -o, --optimized FILE\n"
+      << "                   Optimized AST is exported in dot format to FILE\n"
+      << "  -e, --emit-cache FILE\n"
+      << "                   Optimized AST is saved in binary format to FILE\n"
+      << "  -k, --load-cache FILE\n"
+      << "                   Load the AST from FILE instead of parsing a source\n"
+      << "  -r, --run        Execute the program instead of analyzing it\n"
+      << "  -c, --cfg        Analyze the control flow graph with a worklist\n"
+      << "  -j, --jobs N     Run up to N analyses concurrently\n"
+      << "  -p, --product    Analyze over the reduced product of domains\n"
+      << "  -d, --domain LIST\n"
+      << "                   Analyze only over the comma separated domains\n"
+      << "                   in LIST: " << keys(registry(Domains()), 28)
+      << "\n"
+      << "  -l, --live VARS  Drop dead variables, keeping the comma separated\n"
+      << "                   VARS in the final state\n"
+      << "  -t, --thresholds Widen to the constants of the program first\n"
+      << "  -w, --delay N    Widen loops only after N iterations\n"
+      << "  -n, --narrowing N\n"
+      << "                   Narrow loops by up to N descending iterations\n"
+      << "  -b, --budget N   Give up precision on loops after N iterations\n"
+      << "  -s, --stats      Print statistics about the analyses\n"
       << "  -h, --help       Print this help and exit\n"
       << endl
       << "File:\n"
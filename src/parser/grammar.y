@@ -1,28 +1,54 @@
 /***********************************************************************
  *  Definitions.
  **********************************************************************/
-%{ // Prologue.
-#include <stdio.h>
-#include <string.h>
+%code requires { // Types needed by the interface of the parser.
+#include <stddef.h>
 
 #include "../AST.hpp"
 
-// Bison functions to be exported to flex.
-int yylex(void);
-int yyerror(const char *s);
-int yywrap();
-void set_source_file(FILE *descriptor);
+class Scanner;
+
+// Identifier, referred to by its position in the source code.
+typedef struct{
+  size_t offset;       // Offset of the first character.
+  size_t length;       // Number of characters.
+} Lexeme;
+}
+
+%code provides { // Interface of the parser.
+AST *parse(const char *buffer, size_t length);
+AST *parse(const char *source_path);
+}
+
+%code { // Prologue.
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <iostream>
+#include <sstream>
+
+#include "../scanner/scanner.hpp"
+
+// Functions used by the parser.
+static int yylex(YYSTYPE *value, Scanner *scanner);
+static int yyerror(Scanner *scanner, AST *&ast, const char *s);
+}
+
 
-// Abstract Syntax Tree.
-AST *ast;
-%}
+/* Parser keeps no global state: scanner and tree are parameters. */
+%define api.pure full
+%lex-param   {Scanner *scanner}
+%parse-param {Scanner *scanner} {AST *&ast}
 
 
 /* Union representing each possible type. */
 %union {
    int  integer;        // Integer value.
-   char literal[32];    // Identifier or textual information.
-   AST *tree;           // Reference to abstract syntax (sub) tree.
+   Lexeme literal;      // Identifier in the source code.
+   AST::Index tree;     // Index of an abstract syntax (sub) tree.
 }; 
 
 
@@ -56,52 +82,52 @@ AST *ast;
  * Rules.
  **********************************************************************/
 
-Prog: Stms              { ast = $1; }
-    |                   { ast = NULL; }
+Prog: Stms              { ast->setRoot($1); }
+    |                   { delete ast; ast = NULL; }
 
-Stms: Stm SEQ           { $$ = $1; }
-    | Stms Stm SEQ      { $$ = new AST(AST::Seq, $1, $2); }
+Stms: Stm SEQ           { $$ = ast->node(AST::Blk, $1); }
+    | Stms Stm SEQ      { ast->push($1, $2); $$ = $1; }
 
 
-Stm: VAR ASN AExp  { $$ = new AST(AST::Asn, new AST(AST::Var, $1), $3); }
-   | SKIP               { $$ = new AST(AST::Skp); }
+Stm: VAR ASN AExp  { $$ = ast->node(AST::Asn, ast->node(AST::Var, scanner->text($1), $1.length), $3); }
+   | SKIP               { $$ = ast->node(AST::Skp); }
    | IF BExp
      THEN Stm
-     ELSE Stm           { $$ = new AST(AST::If, $2, $4, $6); }
-   | WHILE BExp DO Stm  { $$ = new AST(AST::Whl, $2, $4); } 
-   | PRINT AExp         { $$ = new AST(AST::Prn, $2); }
-   | INPUT VAR          { $$ = new AST(AST::In, new AST(AST::Var, $2)); }
+     ELSE Stm           { $$ = ast->node(AST::If, $2, $4, $6); }
+   | WHILE BExp DO Stm  { $$ = ast->node(AST::Whl, $2, $4); } 
+   | PRINT AExp         { $$ = ast->node(AST::Prn, $2); }
+   | INPUT VAR          { $$ = ast->node(AST::In, ast->node(AST::Var, scanner->text($2), $2.length)); }
    | LPAR Stms RPAR     { $$ = $2; }
 
-AExp: NUM               { $$ = new AST(AST::Num, $1); }
-    | VAR               { $$ = new AST(AST::Var, $1); }
-    | PLUS AExp         { $$ = new AST(AST::Id, $2); }
-    | MINUS AExp        { $$ = new AST(AST::Opp, $2); }
-    | AExp PLUS AExp    { $$ = new AST(AST::Sum, $1, $3); }
-    | AExp MINUS AExp   { $$ = new AST(AST::Sub, $1, $3); }
-    | AExp STAR AExp    { $$ = new AST(AST::Mul, $1, $3); }
-    | AExp SLASH AExp   { $$ = new AST(AST::Div, $1, $3); }
-    | AExp PERC AExp    { $$ = new AST(AST::Rem, $1, $3); }
-    | AExp CAP AExp     { $$ = new AST(AST::Pow, $1, $3); }
+AExp: NUM               { $$ = ast->node(AST::Num, $1); }
+    | VAR               { $$ = ast->node(AST::Var, scanner->text($1), $1.length); }
+    | PLUS AExp         { $$ = ast->node(AST::Id, $2); }
+    | MINUS AExp        { $$ = ast->node(AST::Opp, $2); }
+    | AExp PLUS AExp    { $$ = ast->node(AST::Sum, $1, $3); }
+    | AExp MINUS AExp   { $$ = ast->node(AST::Sub, $1, $3); }
+    | AExp STAR AExp    { $$ = ast->node(AST::Mul, $1, $3); }
+    | AExp SLASH AExp   { $$ = ast->node(AST::Div, $1, $3); }
+    | AExp PERC AExp    { $$ = ast->node(AST::Rem, $1, $3); }
+    | AExp CAP AExp     { $$ = ast->node(AST::Pow, $1, $3); }
     | LPAR AExp RPAR    { $$ = $2; }
 
-BExp: TRUE              { $$ = new AST(AST::Bool, true); }
-    | FALSE             { $$ = new AST(AST::Bool, false); }
-    | NOT BExp          { $$ = new AST(AST::Not, $2); }
-    | BExp AND BExp     { $$ = new AST(AST::And, $1, $3); }
-    | BExp OR   BExp    { $$ = new AST(AST::Or, $1, $3); }
-    | BExp XOR  BExp    { $$ = new AST(AST::Xor, $1, $3); }
-    | BExp NAND BExp    { $$ = new AST(AST::Nand, $1, $3); }
-    | BExp NOR  BExp    { $$ = new AST(AST::Nor, $1, $3); }
-    | BExp XNOR BExp    { $$ = new AST(AST::Xnor, $1, $3); }
-    | BExp IMP  BExp    { $$ = new AST(AST::Or, new AST(AST::Not, $1), $3); }
-    | BExp RIMP BExp    { $$ = new AST(AST::Or, new AST(AST::Not, $3), $1); }
-    | AExp LT   AExp    { $$ = new AST(AST::Lt, $1, $3); }
-    | AExp LEQ  AExp    { $$ = new AST(AST::Leq, $1, $3); }
-    | AExp EQ   AExp    { $$ = new AST(AST::Eq, $1, $3); }
-    | AExp GEQ  AExp    { $$ = new AST(AST::Geq, $1, $3); }
-    | AExp GT   AExp    { $$ = new AST(AST::Gt, $1, $3); }
-    | AExp NEQ  AExp    { $$ = new AST(AST::Neq, $1, $3); }
+BExp: TRUE              { $$ = ast->node(AST::Bool, true); }
+    | FALSE             { $$ = ast->node(AST::Bool, false); }
+    | NOT BExp          { $$ = ast->node(AST::Not, $2); }
+    | BExp AND BExp     { $$ = ast->node(AST::And, $1, $3); }
+    | BExp OR   BExp    { $$ = ast->node(AST::Or, $1, $3); }
+    | BExp XOR  BExp    { $$ = ast->node(AST::Xor, $1, $3); }
+    | BExp NAND BExp    { $$ = ast->node(AST::Nand, $1, $3); }
+    | BExp NOR  BExp    { $$ = ast->node(AST::Nor, $1, $3); }
+    | BExp XNOR BExp    { $$ = ast->node(AST::Xnor, $1, $3); }
+    | BExp IMP  BExp    { $$ = ast->node(AST::Or, ast->node(AST::Not, $1), $3); }
+    | BExp RIMP BExp    { $$ = ast->node(AST::Or, ast->node(AST::Not, $3), $1); }
+    | AExp LT   AExp    { $$ = ast->node(AST::Lt, $1, $3); }
+    | AExp LEQ  AExp    { $$ = ast->node(AST::Leq, $1, $3); }
+    | AExp EQ   AExp    { $$ = ast->node(AST::Eq, $1, $3); }
+    | AExp GEQ  AExp    { $$ = ast->node(AST::Geq, $1, $3); }
+    | AExp GT   AExp    { $$ = ast->node(AST::Gt, $1, $3); }
+    | AExp NEQ  AExp    { $$ = ast->node(AST::Neq, $1, $3); }
     | LPAR BExp RPAR    { $$ = $2; }
 
 
@@ -110,46 +136,91 @@ BExp: TRUE              { $$ = new AST(AST::Bool, true); }
  * Auxiliary functions.
  **********************************************************************/
 
+/* Next token is read from the scanner. */
+static int yylex(YYSTYPE *value, Scanner *scanner){
+  return scanner->next(value);
+}
+
 /* Error handling function. */
-int yyerror(const char *s) {
+static int yyerror(Scanner *scanner, AST *&ast, const char *s){
+  (void) scanner;
+  (void) ast;
   cout << s << endl;
   return -1;
 }
 
-/* The source file is parsed and the Abstract Syntax Tree is built.*/
-void *parse(const char *source_path){
+/* Source code in memory is parsed and the Abstract Syntax Tree is built.
+ * Every call has its own scanner and tree, so that many programs can be
+ * parsed concurrently. The caller owns the returned tree, which is NULL
+ * if the program is empty or wrong. */
+AST *parse(const char *buffer, size_t length){
+  Scanner scanner(buffer, length);
+  AST *ast = new AST();
   int parse_result;
-  FILE *source_file;
-  
-  
-  /* Source file is opened. */
-  if(strcmp("-", source_path) == 0){
-    cout << "Reading from standard input. Type Ctrl+D to terminate..."
-         << endl;
-    source_file = stdin;
-  }
-  else{
-    source_file = fopen(source_path, "r");
-    if(source_file == NULL){
-      cerr << "[Parser]: Unable to open file \"" << source_path << "\"."
-           << endl;
-      exit(-1);
-    }
-  }
-  set_source_file(source_file);
-  
   
-  /* The source code is parsed. */
-  ast  = NULL;
-  parse_result = yyparse();
+  parse_result = yyparse(&scanner, ast);
   if(parse_result == 1){
     cerr << "[Parser]: Syntax error." << endl;
+    delete ast;
     ast = NULL;
   }
   else if(parse_result == 2){
     cerr << "[Parser]: Memory exhaustion." << endl;
+    delete ast;
     ast = NULL;
   }
   
   return ast;
 }
+
+/* The source file is parsed. Regular files are mapped in memory and
+ * scanned in place, anything else is read into a buffer first. */
+AST *parse(const char *source_path){
+  ostringstream source;
+  struct stat status;
+  string text;
+  void *mapped;
+  int source_file;
+  AST *result;
+  
+  /* Standard input is read. */
+  if(strcmp("-", source_path) == 0){
+    cout << "Reading from standard input. Type Ctrl+D to terminate..."
+         << endl;
+    source << cin.rdbuf();
+    text = source.str();
+    return parse(text.data(), text.size());
+  }
+  
+  /* Source file is opened. */
+  source_file = open(source_path, O_RDONLY);
+  if(source_file < 0 || fstat(source_file, &status) != 0){
+    cerr << "[Parser]: Unable to open file \"" << source_path << "\"."
+         << endl;
+    exit(-1);
+  }
+  
+  /* Source file is mapped, if possible. */
+  mapped = MAP_FAILED;
+  if(S_ISREG(status.st_mode) && status.st_size > 0){
+    mapped = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE,
+                  source_file, 0);
+  }
+  if(mapped != MAP_FAILED){
+    madvise(mapped, status.st_size, MADV_SEQUENTIAL);
+    result = parse((const char *) mapped, status.st_size);
+    munmap(mapped, status.st_size);
+  }
+  else{
+    char chunk[65536];
+    ssize_t bytes;
+    
+    while((bytes = read(source_file, chunk, sizeof(chunk))) > 0){
+      text.append(chunk, bytes);
+    }
+    result = parse(text.data(), text.size());
+  }
+  close(source_file);
+  
+  return result;
+}
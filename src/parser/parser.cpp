@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.5.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2011 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.5"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -58,158 +63,192 @@
 /* Pull parsers.  */
 #define YYPULL 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
 
 
 
-/* Copy the first part of user declarations.  */
 
-/* Line 268 of yacc.c  */
-#line 4 "parser/grammar.y"
- // Prologue.
-#include <stdio.h>
-#include <string.h>
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-#include "../AST.hpp"
+#include "parser.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_NUM = 3,                        /* NUM  */
+  YYSYMBOL_VAR = 4,                        /* VAR  */
+  YYSYMBOL_ASN = 5,                        /* ASN  */
+  YYSYMBOL_SKIP = 6,                       /* SKIP  */
+  YYSYMBOL_SEQ = 7,                        /* SEQ  */
+  YYSYMBOL_IF = 8,                         /* IF  */
+  YYSYMBOL_THEN = 9,                       /* THEN  */
+  YYSYMBOL_WHILE = 10,                     /* WHILE  */
+  YYSYMBOL_DO = 11,                        /* DO  */
+  YYSYMBOL_ELSE = 12,                      /* ELSE  */
+  YYSYMBOL_PLUS = 13,                      /* PLUS  */
+  YYSYMBOL_MINUS = 14,                     /* MINUS  */
+  YYSYMBOL_STAR = 15,                      /* STAR  */
+  YYSYMBOL_SLASH = 16,                     /* SLASH  */
+  YYSYMBOL_PERC = 17,                      /* PERC  */
+  YYSYMBOL_CAP = 18,                       /* CAP  */
+  YYSYMBOL_TRUE = 19,                      /* TRUE  */
+  YYSYMBOL_FALSE = 20,                     /* FALSE  */
+  YYSYMBOL_NOT = 21,                       /* NOT  */
+  YYSYMBOL_AND = 22,                       /* AND  */
+  YYSYMBOL_OR = 23,                        /* OR  */
+  YYSYMBOL_XOR = 24,                       /* XOR  */
+  YYSYMBOL_NAND = 25,                      /* NAND  */
+  YYSYMBOL_NOR = 26,                       /* NOR  */
+  YYSYMBOL_XNOR = 27,                      /* XNOR  */
+  YYSYMBOL_IMP = 28,                       /* IMP  */
+  YYSYMBOL_RIMP = 29,                      /* RIMP  */
+  YYSYMBOL_EQ = 30,                        /* EQ  */
+  YYSYMBOL_NEQ = 31,                       /* NEQ  */
+  YYSYMBOL_LT = 32,                        /* LT  */
+  YYSYMBOL_LEQ = 33,                       /* LEQ  */
+  YYSYMBOL_GEQ = 34,                       /* GEQ  */
+  YYSYMBOL_GT = 35,                        /* GT  */
+  YYSYMBOL_PRINT = 36,                     /* PRINT  */
+  YYSYMBOL_INPUT = 37,                     /* INPUT  */
+  YYSYMBOL_LPAR = 38,                      /* LPAR  */
+  YYSYMBOL_RPAR = 39,                      /* RPAR  */
+  YYSYMBOL_YYACCEPT = 40,                  /* $accept  */
+  YYSYMBOL_Prog = 41,                      /* Prog  */
+  YYSYMBOL_Stms = 42,                      /* Stms  */
+  YYSYMBOL_Stm = 43,                       /* Stm  */
+  YYSYMBOL_AExp = 44,                      /* AExp  */
+  YYSYMBOL_BExp = 45                       /* BExp  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-// Bison functions to be exported to flex.
-int yylex(void);
-int yyerror(const char *s);
-int yywrap();
-void set_source_file(FILE *descriptor);
 
-// Abstract Syntax Tree.
-AST *ast;
 
+/* Unqualified %code blocks.  */
+#line 23 "parser/grammar.y"
+ // Prologue.
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <iostream>
+#include <sstream>
 
-/* Line 268 of yacc.c  */
-#line 88 "parser/parser.cpp"
+#include "../scanner/scanner.hpp"
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
+// Functions used by the parser.
+static int yylex(YYSTYPE *value, Scanner *scanner);
+static int yyerror(Scanner *scanner, AST *&ast, const char *s);
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
+#line 166 "parser/parser.cpp"
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
+#ifdef short
+# undef short
 #endif
 
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     NUM = 258,
-     VAR = 259,
-     ASN = 260,
-     SKIP = 261,
-     SEQ = 262,
-     IF = 263,
-     THEN = 264,
-     WHILE = 265,
-     DO = 266,
-     ELSE = 267,
-     MINUS = 268,
-     PLUS = 269,
-     PERC = 270,
-     SLASH = 271,
-     STAR = 272,
-     CAP = 273,
-     TRUE = 274,
-     FALSE = 275,
-     NOT = 276,
-     XNOR = 277,
-     NOR = 278,
-     NAND = 279,
-     XOR = 280,
-     OR = 281,
-     AND = 282,
-     RIMP = 283,
-     IMP = 284,
-     GT = 285,
-     GEQ = 286,
-     LEQ = 287,
-     LT = 288,
-     NEQ = 289,
-     EQ = 290,
-     PRINT = 291,
-     INPUT = 292,
-     LPAR = 293,
-     RPAR = 294
-   };
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-{
-
-/* Line 293 of yacc.c  */
-#line 22 "parser/grammar.y"
-
-   int  integer;        // Integer value.
-   char literal[32];    // Identifier or textual information.
-   AST *tree;           // Reference to abstract syntax (sub) tree.
-
-
-
-/* Line 293 of yacc.c  */
-#line 171 "parser/parser.cpp"
-} YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-
-/* Copy the second part of user declarations.  */
-
-
-/* Line 343 of yacc.c  */
-#line 183 "parser/parser.cpp"
-
-#ifdef short
-# undef short
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef short int yytype_int8;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef int yytype_uint16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
-#else
-typedef short int yytype_int16;
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -217,55 +256,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -282,9 +372,9 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
 #     ifndef EXIT_SUCCESS
 #      define EXIT_SUCCESS 0
 #     endif
@@ -294,8 +384,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -311,7 +401,7 @@ YYID (yyi)
 #  endif
 #  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
 #   ifndef EXIT_SUCCESS
 #    define EXIT_SUCCESS 0
@@ -319,40 +409,37 @@ YYID (yyi)
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -362,35 +449,35 @@ union yyalloc
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
 #if defined YYCOPY_NEEDED && YYCOPY_NEEDED
-/* Copy COUNT objects from FROM to TO.  The source and destination do
+/* Copy COUNT objects from SRC to DST.  The source and destination do
    not overlap.  */
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
 #  endif
 # endif
 #endif /* !YYCOPY_NEEDED */
@@ -406,18 +493,23 @@ union yyalloc
 #define YYNNTS  6
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  41
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  87
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   294
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -452,118 +544,56 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
-{
-       0,     0,     3,     5,     6,     9,    13,    17,    19,    26,
-      31,    34,    37,    41,    43,    45,    48,    51,    55,    59,
-      63,    67,    71,    75,    79,    81,    83,    86,    90,    94,
-      98,   102,   106,   110,   114,   118,   122,   126,   130,   134,
-     138,   142
-};
-
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      41,     0,    -1,    42,    -1,    -1,    43,     7,    -1,    42,
-      43,     7,    -1,     4,     5,    44,    -1,     6,    -1,     8,
-      45,     9,    43,    12,    43,    -1,    10,    45,    11,    43,
-      -1,    36,    44,    -1,    37,     4,    -1,    38,    42,    39,
-      -1,     3,    -1,     4,    -1,    14,    44,    -1,    13,    44,
-      -1,    44,    14,    44,    -1,    44,    13,    44,    -1,    44,
-      17,    44,    -1,    44,    16,    44,    -1,    44,    15,    44,
-      -1,    44,    18,    44,    -1,    38,    44,    39,    -1,    19,
-      -1,    20,    -1,    21,    45,    -1,    45,    27,    45,    -1,
-      45,    26,    45,    -1,    45,    25,    45,    -1,    45,    24,
-      45,    -1,    45,    23,    45,    -1,    45,    22,    45,    -1,
-      45,    29,    45,    -1,    45,    28,    45,    -1,    44,    33,
-      44,    -1,    44,    32,    44,    -1,    44,    35,    44,    -1,
-      44,    31,    44,    -1,    44,    30,    44,    -1,    44,    34,
-      44,    -1,    38,    45,    39,    -1
-};
-
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,    59,    59,    60,    62,    63,    66,    67,    68,    71,
-      72,    73,    74,    76,    77,    78,    79,    80,    81,    82,
-      83,    84,    85,    86,    88,    89,    90,    91,    92,    93,
-      94,    95,    96,    97,    98,    99,   100,   101,   102,   103,
-     104,   105
+       0,    85,    85,    86,    88,    89,    92,    93,    94,    97,
+      98,    99,   100,   102,   103,   104,   105,   106,   107,   108,
+     109,   110,   111,   112,   114,   115,   116,   117,   118,   119,
+     120,   121,   122,   123,   124,   125,   126,   127,   128,   129,
+     130,   131
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "NUM", "VAR", "ASN", "SKIP", "SEQ", "IF",
-  "THEN", "WHILE", "DO", "ELSE", "MINUS", "PLUS", "PERC", "SLASH", "STAR",
-  "CAP", "TRUE", "FALSE", "NOT", "XNOR", "NOR", "NAND", "XOR", "OR", "AND",
-  "RIMP", "IMP", "GT", "GEQ", "LEQ", "LT", "NEQ", "EQ", "PRINT", "INPUT",
-  "LPAR", "RPAR", "$accept", "Prog", "Stms", "Stm", "AExp", "BExp", 0
+  "\"end of file\"", "error", "\"invalid token\"", "NUM", "VAR", "ASN",
+  "SKIP", "SEQ", "IF", "THEN", "WHILE", "DO", "ELSE", "PLUS", "MINUS",
+  "STAR", "SLASH", "PERC", "CAP", "TRUE", "FALSE", "NOT", "AND", "OR",
+  "XOR", "NAND", "NOR", "XNOR", "IMP", "RIMP", "EQ", "NEQ", "LT", "LEQ",
+  "GEQ", "GT", "PRINT", "INPUT", "LPAR", "RPAR", "$accept", "Prog", "Stms",
+  "Stm", "AExp", "BExp", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    40,    41,    41,    42,    42,    43,    43,    43,    43,
-      43,    43,    43,    44,    44,    44,    44,    44,    44,    44,
-      44,    44,    44,    44,    45,    45,    45,    45,    45,    45,
-      45,    45,    45,    45,    45,    45,    45,    45,    45,    45,
-      45,    45
-};
+#define YYPACT_NINF (-28)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     1,     0,     2,     3,     3,     1,     6,     4,
-       2,     2,     3,     1,     1,     2,     2,     3,     3,     3,
-       3,     3,     3,     3,     1,     1,     2,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default reduction number in state STATE-NUM.
-   Performed when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       3,     0,     7,     0,     0,     0,     0,     0,     0,     2,
-       0,     0,    13,    14,     0,     0,    24,    25,     0,     0,
-       0,     0,     0,     0,    10,    11,     0,     1,     0,     4,
-       6,    16,    15,    26,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,    12,
-       5,    23,    41,    18,    17,    21,    20,    19,    22,    39,
-      38,    36,    35,    40,    37,     0,    32,    31,    30,    29,
-      28,    27,    34,    33,     9,     0,     8
-};
+#define YYTABLE_NINF (-1)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
-{
-      -1,     8,     9,    10,    20,    21
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -28
 static const yytype_int16 yypact[] =
 {
       85,    15,   -28,     8,     8,    74,    -1,    85,    23,    85,
@@ -577,17 +607,38 @@ static const yytype_int16 yypact[] =
      -27,   -27,   -28,   -28,   -28,    85,   -28
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       3,     0,     7,     0,     0,     0,     0,     0,     0,     2,
+       0,     0,    13,    14,     0,     0,    24,    25,     0,     0,
+       0,     0,     0,     0,    10,    11,     0,     1,     0,     4,
+       6,    15,    16,    26,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    12,
+       5,    23,    41,    17,    18,    19,    20,    21,    22,    37,
+      40,    35,    36,    38,    39,     0,    27,    28,    29,    30,
+      31,    32,    33,    34,     9,     0,     8
+};
+
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -28,   -28,    26,    -9,    21,     0
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     8,     9,    10,    20,    21
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const yytype_uint8 yytable[] =
+static const yytype_int8 yytable[] =
 {
       28,    55,    56,    25,    22,    36,    37,    38,    39,    40,
       41,    12,    13,    38,    39,    40,    41,    28,    33,    35,
@@ -609,12 +660,6 @@ static const yytype_uint8 yytable[] =
       53,    54,    55,    56
 };
 
-#define yypact_value_is_default(yystate) \
-  ((yystate) == (-28))
-
-#define yytable_value_is_error(yytable_value) \
-  YYID (0)
-
 static const yytype_int8 yycheck[] =
 {
        9,    28,    29,     4,     4,    13,    14,    15,    16,    17,
@@ -637,9 +682,9 @@ static const yytype_int8 yycheck[] =
       26,    27,    28,    29
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     4,     6,     8,    10,    36,    37,    38,    41,    42,
       43,     5,     3,     4,    13,    14,    19,    20,    21,    38,
@@ -652,94 +697,61 @@ static const yytype_uint8 yystos[] =
       45,    45,    45,    45,    43,    12,    43
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  However,
-   YYFAIL appears to be in use.  Nevertheless, it is formally deprecated
-   in Bison 2.4.2's NEWS entry, where a plan to phase it out is
-   discussed.  */
-
-#define YYFAIL		goto yyerrlab
-#if defined YYFAIL
-  /* This is here to suppress warnings from the GCC cpp's
-     -Wunused-macros.  Normally we don't worry about that warning, but
-     some users do, and we want to make it easy for users to remove
-     YYFAIL uses, which will produce warnings from Bison 2.5.  */
-#endif
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    40,    41,    41,    42,    42,    43,    43,    43,    43,
+      43,    43,    43,    44,    44,    44,    44,    44,    44,    44,
+      44,    44,    44,    44,    45,    45,    45,    45,    45,    45,
+      45,    45,    45,    45,    45,    45,    45,    45,    45,    45,
+      45,    45
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     0,     2,     3,     3,     1,     6,     4,
+       2,     2,     3,     1,     1,     2,     2,     3,     3,     3,
+       3,     3,     3,     3,     1,     1,     2,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3
+};
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
 
+enum { YYENOMEM = -2 };
 
-/* This macro is provided for backward compatibility. */
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (scanner, ast, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -749,80 +761,60 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, scanner, ast); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, Scanner *scanner, AST *&ast)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (scanner);
+  YY_USE (ast);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
 static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, Scanner *scanner, AST *&ast)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner, ast);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -830,16 +822,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
-static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -850,63 +834,56 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, Scanner *scanner, AST *&ast)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner, ast);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner, ast); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -922,365 +899,85 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
 
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (0, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  YYSIZE_T yysize1;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = 0;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - Assume YYFAIL is not used.  It's too flawed to consider.  See
-       <http://lists.gnu.org/archive/html/bison-patches/2009-12/msg00024.html>
-       for details.  YYERROR is fine as it does not invoke this
-       function.
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-                if (! (yysize <= yysize1
-                       && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                  return 2;
-                yysize = yysize1;
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  yysize1 = yysize + yystrlen (yyformat);
-  if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-    return 2;
-  yysize = yysize1;
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, Scanner *scanner, AST *&ast)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
+  YY_USE (ast);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/* Prevent warnings from -Wmissing-prototypes.  */
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 /*----------.
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
-yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
+yyparse (Scanner *scanner, AST *&ast)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* Lookahead token kind.  */
+int yychar;
 
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
 
-       Refer to the stacks thru separate pointers, to allow yyoverflow
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1288,111 +985,107 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yytoken = 0;
-  yyss = yyssa;
-  yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
 
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-  yyssp = yyss;
-  yyvsp = yyvs;
-
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1403,18 +1096,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1442,13 +1146,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1463,14 +1167,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1483,290 +1187,249 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-
-/* Line 1806 of yacc.c  */
-#line 59 "parser/grammar.y"
-    { ast = (yyvsp[(1) - (1)].tree); }
+  case 2: /* Prog: Stms  */
+#line 85 "parser/grammar.y"
+                        { ast->setRoot((yyvsp[0].tree)); }
+#line 1194 "parser/parser.cpp"
     break;
 
-  case 3:
-
-/* Line 1806 of yacc.c  */
-#line 60 "parser/grammar.y"
-    { ast = NULL; }
+  case 3: /* Prog: %empty  */
+#line 86 "parser/grammar.y"
+                        { delete ast; ast = NULL; }
+#line 1200 "parser/parser.cpp"
     break;
 
-  case 4:
-
-/* Line 1806 of yacc.c  */
-#line 62 "parser/grammar.y"
-    { (yyval.tree) = (yyvsp[(1) - (2)].tree); }
+  case 4: /* Stms: Stm SEQ  */
+#line 88 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Blk, (yyvsp[-1].tree)); }
+#line 1206 "parser/parser.cpp"
     break;
 
-  case 5:
-
-/* Line 1806 of yacc.c  */
-#line 63 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Seq, (yyvsp[(1) - (3)].tree), (yyvsp[(2) - (3)].tree)); }
+  case 5: /* Stms: Stms Stm SEQ  */
+#line 89 "parser/grammar.y"
+                        { ast->push((yyvsp[-2].tree), (yyvsp[-1].tree)); (yyval.tree) = (yyvsp[-2].tree); }
+#line 1212 "parser/parser.cpp"
     break;
 
-  case 6:
-
-/* Line 1806 of yacc.c  */
-#line 66 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Asn, new AST(AST::Var, (yyvsp[(1) - (3)].literal)), (yyvsp[(3) - (3)].tree)); }
+  case 6: /* Stm: VAR ASN AExp  */
+#line 92 "parser/grammar.y"
+                   { (yyval.tree) = ast->node(AST::Asn, ast->node(AST::Var, scanner->text((yyvsp[-2].literal)), (yyvsp[-2].literal).length), (yyvsp[0].tree)); }
+#line 1218 "parser/parser.cpp"
     break;
 
-  case 7:
-
-/* Line 1806 of yacc.c  */
-#line 67 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Skp); }
+  case 7: /* Stm: SKIP  */
+#line 93 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Skp); }
+#line 1224 "parser/parser.cpp"
     break;
 
-  case 8:
-
-/* Line 1806 of yacc.c  */
-#line 70 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::If, (yyvsp[(2) - (6)].tree), (yyvsp[(4) - (6)].tree), (yyvsp[(6) - (6)].tree)); }
+  case 8: /* Stm: IF BExp THEN Stm ELSE Stm  */
+#line 96 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::If, (yyvsp[-4].tree), (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1230 "parser/parser.cpp"
     break;
 
-  case 9:
-
-/* Line 1806 of yacc.c  */
-#line 71 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Whl, (yyvsp[(2) - (4)].tree), (yyvsp[(4) - (4)].tree)); }
+  case 9: /* Stm: WHILE BExp DO Stm  */
+#line 97 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Whl, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1236 "parser/parser.cpp"
     break;
 
-  case 10:
-
-/* Line 1806 of yacc.c  */
-#line 72 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Prn, (yyvsp[(2) - (2)].tree)); }
+  case 10: /* Stm: PRINT AExp  */
+#line 98 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Prn, (yyvsp[0].tree)); }
+#line 1242 "parser/parser.cpp"
     break;
 
-  case 11:
-
-/* Line 1806 of yacc.c  */
-#line 73 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::In, new AST(AST::Var, (yyvsp[(2) - (2)].literal))); }
+  case 11: /* Stm: INPUT VAR  */
+#line 99 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::In, ast->node(AST::Var, scanner->text((yyvsp[0].literal)), (yyvsp[0].literal).length)); }
+#line 1248 "parser/parser.cpp"
     break;
 
-  case 12:
-
-/* Line 1806 of yacc.c  */
-#line 74 "parser/grammar.y"
-    { (yyval.tree) = (yyvsp[(2) - (3)].tree); }
+  case 12: /* Stm: LPAR Stms RPAR  */
+#line 100 "parser/grammar.y"
+                        { (yyval.tree) = (yyvsp[-1].tree); }
+#line 1254 "parser/parser.cpp"
     break;
 
-  case 13:
-
-/* Line 1806 of yacc.c  */
-#line 76 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Num, (yyvsp[(1) - (1)].integer)); }
+  case 13: /* AExp: NUM  */
+#line 102 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Num, (yyvsp[0].integer)); }
+#line 1260 "parser/parser.cpp"
     break;
 
-  case 14:
-
-/* Line 1806 of yacc.c  */
-#line 77 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Var, (yyvsp[(1) - (1)].literal)); }
+  case 14: /* AExp: VAR  */
+#line 103 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Var, scanner->text((yyvsp[0].literal)), (yyvsp[0].literal).length); }
+#line 1266 "parser/parser.cpp"
     break;
 
-  case 15:
-
-/* Line 1806 of yacc.c  */
-#line 78 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Id, (yyvsp[(2) - (2)].tree)); }
+  case 15: /* AExp: PLUS AExp  */
+#line 104 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Id, (yyvsp[0].tree)); }
+#line 1272 "parser/parser.cpp"
     break;
 
-  case 16:
-
-/* Line 1806 of yacc.c  */
-#line 79 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Opp, (yyvsp[(2) - (2)].tree)); }
+  case 16: /* AExp: MINUS AExp  */
+#line 105 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Opp, (yyvsp[0].tree)); }
+#line 1278 "parser/parser.cpp"
     break;
 
-  case 17:
-
-/* Line 1806 of yacc.c  */
-#line 80 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Sum, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 17: /* AExp: AExp PLUS AExp  */
+#line 106 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Sum, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1284 "parser/parser.cpp"
     break;
 
-  case 18:
-
-/* Line 1806 of yacc.c  */
-#line 81 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Sub, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 18: /* AExp: AExp MINUS AExp  */
+#line 107 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Sub, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1290 "parser/parser.cpp"
     break;
 
-  case 19:
-
-/* Line 1806 of yacc.c  */
-#line 82 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Mul, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 19: /* AExp: AExp STAR AExp  */
+#line 108 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Mul, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1296 "parser/parser.cpp"
     break;
 
-  case 20:
-
-/* Line 1806 of yacc.c  */
-#line 83 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Div, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 20: /* AExp: AExp SLASH AExp  */
+#line 109 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Div, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1302 "parser/parser.cpp"
     break;
 
-  case 21:
-
-/* Line 1806 of yacc.c  */
-#line 84 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Rem, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 21: /* AExp: AExp PERC AExp  */
+#line 110 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Rem, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1308 "parser/parser.cpp"
     break;
 
-  case 22:
-
-/* Line 1806 of yacc.c  */
-#line 85 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Pow, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 22: /* AExp: AExp CAP AExp  */
+#line 111 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Pow, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1314 "parser/parser.cpp"
     break;
 
-  case 23:
-
-/* Line 1806 of yacc.c  */
-#line 86 "parser/grammar.y"
-    { (yyval.tree) = (yyvsp[(2) - (3)].tree); }
+  case 23: /* AExp: LPAR AExp RPAR  */
+#line 112 "parser/grammar.y"
+                        { (yyval.tree) = (yyvsp[-1].tree); }
+#line 1320 "parser/parser.cpp"
     break;
 
-  case 24:
-
-/* Line 1806 of yacc.c  */
-#line 88 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Bool, true); }
+  case 24: /* BExp: TRUE  */
+#line 114 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Bool, true); }
+#line 1326 "parser/parser.cpp"
     break;
 
-  case 25:
-
-/* Line 1806 of yacc.c  */
-#line 89 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Bool, false); }
+  case 25: /* BExp: FALSE  */
+#line 115 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Bool, false); }
+#line 1332 "parser/parser.cpp"
     break;
 
-  case 26:
-
-/* Line 1806 of yacc.c  */
-#line 90 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Not, (yyvsp[(2) - (2)].tree)); }
+  case 26: /* BExp: NOT BExp  */
+#line 116 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Not, (yyvsp[0].tree)); }
+#line 1338 "parser/parser.cpp"
     break;
 
-  case 27:
-
-/* Line 1806 of yacc.c  */
-#line 91 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::And, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 27: /* BExp: BExp AND BExp  */
+#line 117 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::And, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1344 "parser/parser.cpp"
     break;
 
-  case 28:
-
-/* Line 1806 of yacc.c  */
-#line 92 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Or, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 28: /* BExp: BExp OR BExp  */
+#line 118 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Or, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1350 "parser/parser.cpp"
     break;
 
-  case 29:
-
-/* Line 1806 of yacc.c  */
-#line 93 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Xor, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 29: /* BExp: BExp XOR BExp  */
+#line 119 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Xor, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1356 "parser/parser.cpp"
     break;
 
-  case 30:
-
-/* Line 1806 of yacc.c  */
-#line 94 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Nand, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 30: /* BExp: BExp NAND BExp  */
+#line 120 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Nand, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1362 "parser/parser.cpp"
     break;
 
-  case 31:
-
-/* Line 1806 of yacc.c  */
-#line 95 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Nor, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 31: /* BExp: BExp NOR BExp  */
+#line 121 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Nor, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1368 "parser/parser.cpp"
     break;
 
-  case 32:
-
-/* Line 1806 of yacc.c  */
-#line 96 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Xnor, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 32: /* BExp: BExp XNOR BExp  */
+#line 122 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Xnor, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1374 "parser/parser.cpp"
     break;
 
-  case 33:
-
-/* Line 1806 of yacc.c  */
-#line 97 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Or, new AST(AST::Not, (yyvsp[(1) - (3)].tree)), (yyvsp[(3) - (3)].tree)); }
+  case 33: /* BExp: BExp IMP BExp  */
+#line 123 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Or, ast->node(AST::Not, (yyvsp[-2].tree)), (yyvsp[0].tree)); }
+#line 1380 "parser/parser.cpp"
     break;
 
-  case 34:
-
-/* Line 1806 of yacc.c  */
-#line 98 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Or, new AST(AST::Not, (yyvsp[(3) - (3)].tree)), (yyvsp[(1) - (3)].tree)); }
+  case 34: /* BExp: BExp RIMP BExp  */
+#line 124 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Or, ast->node(AST::Not, (yyvsp[0].tree)), (yyvsp[-2].tree)); }
+#line 1386 "parser/parser.cpp"
     break;
 
-  case 35:
-
-/* Line 1806 of yacc.c  */
-#line 99 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Lt, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 35: /* BExp: AExp LT AExp  */
+#line 125 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Lt, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1392 "parser/parser.cpp"
     break;
 
-  case 36:
-
-/* Line 1806 of yacc.c  */
-#line 100 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Leq, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 36: /* BExp: AExp LEQ AExp  */
+#line 126 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Leq, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1398 "parser/parser.cpp"
     break;
 
-  case 37:
-
-/* Line 1806 of yacc.c  */
-#line 101 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Eq, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 37: /* BExp: AExp EQ AExp  */
+#line 127 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Eq, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1404 "parser/parser.cpp"
     break;
 
-  case 38:
-
-/* Line 1806 of yacc.c  */
-#line 102 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Geq, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 38: /* BExp: AExp GEQ AExp  */
+#line 128 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Geq, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1410 "parser/parser.cpp"
     break;
 
-  case 39:
-
-/* Line 1806 of yacc.c  */
-#line 103 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Gt, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 39: /* BExp: AExp GT AExp  */
+#line 129 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Gt, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1416 "parser/parser.cpp"
     break;
 
-  case 40:
-
-/* Line 1806 of yacc.c  */
-#line 104 "parser/grammar.y"
-    { (yyval.tree) = new AST(AST::Neq, (yyvsp[(1) - (3)].tree), (yyvsp[(3) - (3)].tree)); }
+  case 40: /* BExp: AExp NEQ AExp  */
+#line 130 "parser/grammar.y"
+                        { (yyval.tree) = ast->node(AST::Neq, (yyvsp[-2].tree), (yyvsp[0].tree)); }
+#line 1422 "parser/parser.cpp"
     break;
 
-  case 41:
-
-/* Line 1806 of yacc.c  */
-#line 105 "parser/grammar.y"
-    { (yyval.tree) = (yyvsp[(2) - (3)].tree); }
+  case 41: /* BExp: LPAR BExp RPAR  */
+#line 131 "parser/grammar.y"
+                        { (yyval.tree) = (yyvsp[-1].tree); }
+#line 1428 "parser/parser.cpp"
     break;
 
 
+#line 1432 "parser/parser.cpp"
 
-/* Line 1806 of yacc.c  */
-#line 1770 "parser/parser.cpp"
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1780,96 +1443,58 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (scanner, ast, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, scanner, ast);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -1881,14 +1506,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -1901,39 +1525,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner, ast);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -1944,105 +1571,146 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined(yyoverflow) || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (scanner, ast, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, scanner, ast);
     }
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner, ast);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
-
 
+  return yyresult;
+}
 
-/* Line 2067 of yacc.c  */
-#line 109 "parser/grammar.y"
+#line 135 "parser/grammar.y"
 /*********************************************************************
  * Auxiliary functions.
  **********************************************************************/
 
+/* Next token is read from the scanner. */
+static int yylex(YYSTYPE *value, Scanner *scanner){
+  return scanner->next(value);
+}
+
 /* Error handling function. */
-int yyerror(const char *s) {
+static int yyerror(Scanner *scanner, AST *&ast, const char *s){
+  (void) scanner;
+  (void) ast;
   cout << s << endl;
   return -1;
 }
 
-/* The source file is parsed and the Abstract Syntax Tree is built.*/
-void *parse(const char *source_path){
+/* Source code in memory is parsed and the Abstract Syntax Tree is built.
+ * Every call has its own scanner and tree, so that many programs can be
+ * parsed concurrently. The caller owns the returned tree, which is NULL
+ * if the program is empty or wrong. */
+AST *parse(const char *buffer, size_t length){
+  Scanner scanner(buffer, length);
+  AST *ast = new AST();
   int parse_result;
-  FILE *source_file;
   
-  
-  /* Source file is opened. */
-  if(strcmp("-", source_path) == 0){
-    cout << "Reading from standard input. Type Ctrl+D to terminate..."
-         << endl;
-    source_file = stdin;
-  }
-  else{
-    source_file = fopen(source_path, "r");
-    if(source_file == NULL){
-      cerr << "[Parser]: Unable to open file \"" << source_path << "\"."
-           << endl;
-      exit(-1);
-    }
-  }
-  set_source_file(source_file);
-  
-  
-  /* The source code is parsed. */
-  ast  = NULL;
-  parse_result = yyparse();
+  parse_result = yyparse(&scanner, ast);
   if(parse_result == 1){
     cerr << "[Parser]: Syntax error." << endl;
+    delete ast;
     ast = NULL;
   }
   else if(parse_result == 2){
     cerr << "[Parser]: Memory exhaustion." << endl;
+    delete ast;
     ast = NULL;
   }
   
   return ast;
 }
 
+/* The source file is parsed. Regular files are mapped in memory and
+ * scanned in place, anything else is read into a buffer first. */
+AST *parse(const char *source_path){
+  ostringstream source;
+  struct stat status;
+  string text;
+  void *mapped;
+  int source_file;
+  AST *result;
+  
+  /* Standard input is read. */
+  if(strcmp("-", source_path) == 0){
+    cout << "Reading from standard input. Type Ctrl+D to terminate..."
+         << endl;
+    source << cin.rdbuf();
+    text = source.str();
+    return parse(text.data(), text.size());
+  }
+  
+  /* Source file is opened. */
+  source_file = open(source_path, O_RDONLY);
+  if(source_file < 0 || fstat(source_file, &status) != 0){
+    cerr << "[Parser]: Unable to open file \"" << source_path << "\"."
+         << endl;
+    exit(-1);
+  }
+  
+  /* Source file is mapped, if possible. */
+  mapped = MAP_FAILED;
+  if(S_ISREG(status.st_mode) && status.st_size > 0){
+    mapped = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE,
+                  source_file, 0);
+  }
+  if(mapped != MAP_FAILED){
+    madvise(mapped, status.st_size, MADV_SEQUENTIAL);
+    result = parse((const char *) mapped, status.st_size);
+    munmap(mapped, status.st_size);
+  }
+  else{
+    char chunk[65536];
+    ssize_t bytes;
+    
+    while((bytes = read(source_file, chunk, sizeof(chunk))) > 0){
+      text.append(chunk, bytes);
+    }
+    result = parse(text.data(), text.size());
+  }
+  close(source_file);
+  
+  return result;
+}
@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.5.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2011 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,80 +27,119 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     NUM = 258,
-     VAR = 259,
-     ASN = 260,
-     SKIP = 261,
-     SEQ = 262,
-     IF = 263,
-     THEN = 264,
-     WHILE = 265,
-     DO = 266,
-     ELSE = 267,
-     MINUS = 268,
-     PLUS = 269,
-     PERC = 270,
-     SLASH = 271,
-     STAR = 272,
-     CAP = 273,
-     TRUE = 274,
-     FALSE = 275,
-     NOT = 276,
-     XNOR = 277,
-     NOR = 278,
-     NAND = 279,
-     XOR = 280,
-     OR = 281,
-     AND = 282,
-     RIMP = 283,
-     IMP = 284,
-     GT = 285,
-     GEQ = 286,
-     LEQ = 287,
-     LT = 288,
-     NEQ = 289,
-     EQ = 290,
-     PRINT = 291,
-     INPUT = 292,
-     LPAR = 293,
-     RPAR = 294
-   };
+#ifndef YY_YY_PARSER_PARSER_HPP_INCLUDED
+# define YY_YY_PARSER_PARSER_HPP_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 4 "parser/grammar.y"
+ // Types needed by the interface of the parser.
+#include <stddef.h>
+
+#include "../AST.hpp"
+
+class Scanner;
 
+// Identifier, referred to by its position in the source code.
+typedef struct{
+  size_t offset;       // Offset of the first character.
+  size_t length;       // Number of characters.
+} Lexeme;
 
+#line 63 "parser/parser.hpp"
 
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    NUM = 258,                     /* NUM  */
+    VAR = 259,                     /* VAR  */
+    ASN = 260,                     /* ASN  */
+    SKIP = 261,                    /* SKIP  */
+    SEQ = 262,                     /* SEQ  */
+    IF = 263,                      /* IF  */
+    THEN = 264,                    /* THEN  */
+    WHILE = 265,                   /* WHILE  */
+    DO = 266,                      /* DO  */
+    ELSE = 267,                    /* ELSE  */
+    PLUS = 268,                    /* PLUS  */
+    MINUS = 269,                   /* MINUS  */
+    STAR = 270,                    /* STAR  */
+    SLASH = 271,                   /* SLASH  */
+    PERC = 272,                    /* PERC  */
+    CAP = 273,                     /* CAP  */
+    TRUE = 274,                    /* TRUE  */
+    FALSE = 275,                   /* FALSE  */
+    NOT = 276,                     /* NOT  */
+    AND = 277,                     /* AND  */
+    OR = 278,                      /* OR  */
+    XOR = 279,                     /* XOR  */
+    NAND = 280,                    /* NAND  */
+    NOR = 281,                     /* NOR  */
+    XNOR = 282,                    /* XNOR  */
+    IMP = 283,                     /* IMP  */
+    RIMP = 284,                    /* RIMP  */
+    EQ = 285,                      /* EQ  */
+    NEQ = 286,                     /* NEQ  */
+    LT = 287,                      /* LT  */
+    LEQ = 288,                     /* LEQ  */
+    GEQ = 289,                     /* GEQ  */
+    GT = 290,                      /* GT  */
+    PRINT = 291,                   /* PRINT  */
+    INPUT = 292,                   /* INPUT  */
+    LPAR = 293,                    /* LPAR  */
+    RPAR = 294                     /* RPAR  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-
-/* Line 2068 of yacc.c  */
-#line 22 "parser/grammar.y"
+#line 48 "parser/grammar.y"
 
    int  integer;        // Integer value.
-   char literal[32];    // Identifier or textual information.
-   AST *tree;           // Reference to abstract syntax (sub) tree.
+   Lexeme literal;      // Identifier in the source code.
+   AST::Index tree;     // Index of an abstract syntax (sub) tree.
 
+#line 125 "parser/parser.hpp"
 
-
-/* Line 2068 of yacc.c  */
-#line 97 "parser/parser.hpp"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE yylval;
 
 
+
+int yyparse (Scanner *scanner, AST *&ast);
+
+/* "%code provides" blocks.  */
+#line 18 "parser/grammar.y"
+ // Interface of the parser.
+AST *parse(const char *buffer, size_t length);
+AST *parse(const char *source_path);
+
+#line 144 "parser/parser.hpp"
+
+#endif /* !YY_YY_PARSER_PARSER_HPP_INCLUDED  */
@@ -0,0 +1,66 @@
+/** Scanner of the While language.
+ * Class splitting the source code of a program into the tokens read by
+ * the parser.
+ *
+ * @file scanner.hpp
+ * @author Marco Zanella <marco.zanella.9@studenti.unipd.it>
+ */
+#ifndef SCANNER_HPP
+#define SCANNER_HPP
+
+#include <stddef.h>
+
+#include "../parser/parser.hpp"
+
+using namespace std;
+
+
+/** Class representing a scanner over an in-memory source code.
+ * Every piece of state lives in the instance, so that many programs can
+ * be scanned concurrently, each by its own scanner. Source code is
+ * never copied: identifiers are referred to by their offset in it.
+ * Tokens follow the longest match rule; keywords win over identifiers
+ * of the same length.
+ */
+class Scanner
+{
+  public:
+  /** Constructor of a scanner over the given source code.
+   * Buffer is not copied, and shall outlive the scanner.
+   * @param[in]  buffer      Source code
+   * @param[in]  length      Length of the source code
+   */
+  Scanner(const char *buffer, size_t length);
+
+
+  /** Next token is read.
+   * Spaces and comments are skipped, unrecognized characters are
+   * reported and skipped.
+   * @param[out] value       Semantic value of the token, if any
+   * @retval     int         Token, 0 at the end of the source code
+   */
+  int next(YYSTYPE *value);
+
+
+  /** Text of a lexeme is provided.
+   * @param[in]  lexeme      Lexeme read by the scanner
+   * @retval     const char * First character of the lexeme, which is not
+   *                         terminated
+   */
+  const char *text(Lexeme lexeme) const;
+
+
+  private:
+  const char *begin;      ///< Start of the source code
+  const char *current;    ///< Next character to be read
+  const char *end;        ///< End of the source code
+
+
+  /** Predicate testing whether the next character is the given one.
+   * Matched character is consumed.
+   * @param[in]  c           Character to be matched
+   * @retval     bool        True if the character was matched
+   */
+  bool accept(char c);
+};
+#endif